@@ -0,0 +1,83 @@
+"""
+This file turns a dump of the TSRI register access trace (see `include/tsri/backends/traced.hpp`) into a readable
+access log, oldest access first.
+
+The dump (trace_file) is the raw memory of `tsri::backends::trace_buffer`, e.g. from GDB:
+    dump binary value trace.bin tsri::backends::trace_buffer
+
+The trace records peripheral and register indices instead of addresses. They are turned into names using the SVD file
+that the headers were generated from (svd_file), with the same indices as the generator's '--trace' option. Without the
+SVD file, the indices are printed.
+"""
+import struct
+import sys
+from argparse import ArgumentParser
+
+TRACE_MAGIC = 0x54525354
+UNKNOWN_PERIPHERAL = 0xFFF
+KINDS = ["read", "write", "write-xor", "write-set", "write-clear", "modify", "toggle"]
+
+### Parse command line arguments ###
+arg_parser = ArgumentParser(description="Decode a TSRI register access trace.")
+arg_parser.add_argument("trace_file", help="Path to the dump of the trace buffer.")
+arg_parser.add_argument("svd_file", nargs="?", default="", help="Path to the SVD file that the headers were generated from.")
+arg_parser.add_argument("--big-endian", action="store_true", help="The trace was recorded on a big-endian target.")
+args = arg_parser.parse_args()
+
+byte_order = ">" if args.big_endian else "<"
+
+### Read the trace buffer ###
+with open(args.trace_file, "rb") as f:
+    dump = f.read()
+
+if len(dump) < 16:
+    sys.exit("The trace dump is too small.")
+
+magic, size, position, _ = struct.unpack_from(f"{byte_order}IIII", dump, 0)
+if magic != TRACE_MAGIC:
+    sys.exit(f"The dump is not a TSRI trace (magic 0x{magic:08X}). Is the byte order correct?")
+if len(dump) < 16 + size * 8:
+    sys.exit(f"The trace dump is truncated: expected {size} entries.")
+
+entries = struct.unpack_from(f"{byte_order}{size}Q", dump, 16)
+
+### Construct the name tables ###
+peripherals = {}
+if args.svd_file != "":
+    from cmsis_svd import SVDParser
+    import helpers
+
+    device = SVDParser.for_xml_file(args.svd_file).get_device()
+    for peripheral in helpers.parse_peripherals(device):
+        peripherals[peripheral.index] = peripheral
+
+def get_register_name(peripheral_index: int, register_index: int) -> str:
+    """
+    Return the name of the register with the given indices, or a description of the indices if it is unknown.
+    """
+    if peripheral_index == UNKNOWN_PERIPHERAL:
+        return f"<unknown>+0x{register_index:X}"
+    if peripheral_index not in peripherals:
+        return f"<peripheral {peripheral_index}>.<register {register_index}>"
+
+    peripheral = peripherals[peripheral_index]
+    registers = peripheral.get_trace_registers()
+    if register_index >= len(registers):
+        return f"{peripheral.name}.<register {register_index}>"
+
+    return f"{peripheral.name}.{registers[register_index].name}"
+
+### Print the entries, oldest first ###
+first = max(0, position - size)
+if position > size:
+    print(f"# {position - size} older accesses were overwritten")
+
+for sequence in range(first, position):
+    entry = entries[sequence % size]
+    value = entry & 0xFFFFFFFF
+    register_index = (entry >> 32) & 0xFFFF
+    peripheral_index = (entry >> 48) & 0xFFF
+    kind = entry >> 60
+    kind_name = KINDS[kind] if kind < len(KINDS) else f"<kind {kind}>"
+
+    print(f"{sequence:>10}  {kind_name:<11}  {get_register_name(peripheral_index, register_index):<40}  0x{value:08X}")
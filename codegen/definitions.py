@@ -26,10 +26,12 @@ class AccessType(Enum):
         raise ValueError("Invalid conversion from fields access to register access.")
 
 class EnumValue:
-    def __init__(self, name: str, description: str, value: str):
+    def __init__(self, name: str, description: str, value: str, is_default: bool = False):
         self.name = name
         self.description = description
         self.value = EnumValue.parse_value(str(value))
+        # Added by the generator to fields without enumerated values in the SVD file.
+        self.is_default = is_default
 
     def __repr__(self):
         return f"{self.name} = {self.value}"
@@ -59,29 +61,141 @@ class Field:
         return f"{self.name} [{self.start_bit + self.length_in_bits - 1}:{self.start_bit}] = 0b{self.value_on_reset:0{self.bit_width}b} ({self.access_type.value}){enum_str}"
 
 class Register:
-    def __init__(self, name: str, description: str, base_address: int, address_offset: int, value_on_reset: int, supports_atomic_bit_operations: bool, access_type: AccessType, fields: List[Field] = []):
+    def __init__(self, name: str, description: str, base_address: int, address_offset: int, size: int, value_on_reset: int, supports_atomic_bit_operations: bool, access_type: AccessType, fields: List[Field] = []):
         self.name = name
         self.description = description
         self.base_address = base_address
         self.address_offset = address_offset
+        self.size = size
         self.value_on_reset = value_on_reset
         self.supports_atomic_bit_operations = supports_atomic_bit_operations
         self.access_type = access_type
         self.fields = fields
+        self.is_volatile = False
+
+    def get_field_name_table(self) -> List[tuple]:
+        """
+        Return the fields in the name table of the register (see the generator's '--names' option), sorted by start bit.
+        Each field comes with the index of its first enumerated value in `get_enum_name_table()` and its number of
+        enumerated values. The default enumerated values of the generator are left out, so those fields are printed as
+        numbers.
+        """
+        table = []
+        first_enum = 0
+        for field in sorted(self.fields, key=lambda field: field.start_bit):
+            number_of_enums = len([enum for enum in field.enum_values if not enum.is_default])
+            table.append((field, first_enum, number_of_enums))
+            first_enum += number_of_enums
+        return table
+
+    def get_enum_name_table(self) -> List[EnumValue]:
+        """
+        Return the enumerated values in the name table of the register, grouped by field in the order of
+        `get_field_name_table()`.
+        """
+        return [enum for field, _, _ in self.get_field_name_table() for enum in field.enum_values if not enum.is_default]
 
     def __repr__(self):
         field_str = "\n        ".join(str(field) for field in self.fields)
 
-        return f"{self.name} @ 0x{self.base_address + self.address_offset:08X} = 0x{self.value_on_reset:08X} ({self.access_type.value}) {'ATOMIC' if self.supports_atomic_bit_operations else ''}\n        {field_str}"
+        return f"{self.name} @ 0x{self.base_address + self.address_offset:08X} = 0x{self.value_on_reset:0{self.size // 4}X} ({self.size}-bit, {self.access_type.value}) {'ATOMIC' if self.supports_atomic_bit_operations else ''}\n        {field_str}"
+
+class CompositeRead(Enum):
+    LOW_LATCHES_HIGH = "low_latches_high"
+    HIGH_LOW_HIGH = "high_low_high"
+
+class Composite:
+    def __init__(self, name: str, description: str, low: Register, high: Register, read: CompositeRead):
+        self.name = name
+        self.description = description
+        self.low = low
+        self.high = high
+        self.read = read
+
+    def __repr__(self):
+        return f"{self.name} = {self.high.name}:{self.low.name} ({self.read.value})"
+
+class Endpoint:
+    def __init__(self, name: str, register: Register, dreq: int):
+        self.name = name
+        self.register = register
+        # Data request signal that paces DMA transfers to or from the register.
+        self.dreq = dreq
+
+    def __repr__(self):
+        return f"{self.name} = {self.register.name} (DREQ {self.dreq})"
 
 class Peripheral:
-    def __init__(self, name: str, description: str, base_address: int, registers: List[Register] = []):
+    def __init__(self, name: str, description: str, base_address: int, registers: List[Register] = [], index: int = 0):
         self.name = name
         self.description = description
         self.base_address = base_address
         self.registers = registers
+        self.composites: List[Composite] = []
+        self.endpoints: List[Endpoint] = []
+        # Position of the peripheral in the SVD file, which identifies it in register access traces.
+        self.index = index
+
+    def get_retained_register_offsets(self) -> List[int]:
+        """
+        Return the sorted address offsets of the registers that are saved and restored by the peripheral's `save()` and
+        `restore()` functions. Only registers that hold configuration are retained: registers with write-only,
+        self-clearing or write-clear fields are skipped, as are registers without any read-write fields.
+        The saved state holds 32-bit words, so only 32-bit registers are retained.
+        """
+        offsets = set()
+        for register in self.registers:
+            field_access_types = set(field.access_type for field in register.fields)
+            if register.size == 32 and AccessType.READ_WRITE in field_access_types and field_access_types <= {AccessType.READ_WRITE, AccessType.READ_ONLY}:
+                offsets.add(register.address_offset)
+        return sorted(offsets)
+
+    def get_cached_registers(self) -> List[Register]:
+        """
+        Return the registers that are kept in the register cache, sorted by address offset. Only registers that change
+        when they are written are cached: registers with read-only, self-clearing or write-clear fields are skipped, as
+        are registers that the overlay marks as volatile (e.g. data registers of FIFOs). The cache holds 32-bit values,
+        so registers wider than 32 bits are skipped too.
+        """
+        cached = {}
+        for register in self.registers:
+            field_access_types = set(field.access_type for field in register.fields)
+            if register.size <= 32 and not register.is_volatile and len(field_access_types) > 0 and field_access_types <= {AccessType.READ_WRITE, AccessType.WRITE_ONLY}:
+                cached.setdefault(register.address_offset, register)
+        return [cached[offset] for offset in sorted(cached)]
+
+    def get_side_effect_offsets(self) -> List[int]:
+        """
+        Return the sorted address offsets of the registers whose accesses have side effects on the device, which the
+        co-simulation backend forwards to the device model. These are the registers with write-only, self-clearing or
+        write-clear fields (commands, FIFO writes and interrupt acknowledgements), and the registers that the overlay
+        marks as volatile (e.g. FIFO reads).
+        """
+        offsets = set()
+        for register in self.registers:
+            field_access_types = set(field.access_type for field in register.fields)
+            if register.is_volatile or field_access_types & {AccessType.WRITE_ONLY, AccessType.SELF_CLEARING, AccessType.WRITE_CLEAR}:
+                offsets.add(register.address_offset)
+        return sorted(offsets)
+
+    def get_trace_registers(self) -> List[Register]:
+        """
+        Return the registers in the order of their indices in register access traces: sorted by address offset. Of
+        registers that share an offset, only the first one is used.
+        """
+        registers = {}
+        for register in self.registers:
+            registers.setdefault(register.address_offset, register)
+        return [registers[offset] for offset in sorted(registers)]
+
+    def get_named_registers(self) -> List[Register]:
+        """
+        Return the registers that get a name table, sorted by address offset. Of registers that share an offset, only the
+        first one is used.
+        """
+        return self.get_trace_registers()
 
     def __repr__(self):
-        register_str = "\n    ".join(str(register) for register in self.registers)
+        register_str = "\n    ".join(str(register) for register in self.registers + self.composites + self.endpoints)
 
         return f"{self.name} @ 0x{self.base_address:08X}\n    {register_str}"
\ No newline at end of file
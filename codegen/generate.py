@@ -5,6 +5,9 @@ The generated headers are put in the provided output folder (output_dir).
 
 By default, the script clears the target folder of all '.hpp' files. This can be disabled using the --no-clear flag.
 
+Information that the SVD file does not contain, such as registers that together form a 64-bit counter, can be added
+with a JSON overlay file using the '--overlay' option. See `helpers.apply_overlay` for the format.
+
 By default, generated code is minimised to safe some space. I deem this acceptable since it is not really meant to be
 read by a person, but there is an option to 'prettify' the code using the '--pretty' flag.
 """
@@ -27,6 +30,14 @@ arg_parser.add_argument("-l", "--list-output-files", action="store_true", help="
 arg_parser.add_argument("-n", "--no-clear", action="store_true", help="Do not clear the output directory header files.")
 arg_parser.add_argument("-p", "--pretty", action="store_true", help="Keep the code layout somewhat pretty. By default, this is false: all whitespace is removed to reduce memory footprint.")
 arg_parser.add_argument("--namespace", default="", help="C++ namespace to put the registers in")
+arg_parser.add_argument("-o", "--overlay", default="", help="JSON overlay file with information that is not in the SVD file, such as composite registers and DMA endpoints.")
+arg_parser.add_argument("--narrow-writes", action="store_true", help="Mark the peripheral buses as supporting byte and halfword writes, so fields that occupy a whole lane are written without a read-modify-write.")
+backend_group = arg_parser.add_mutually_exclusive_group()
+backend_group.add_argument("--mapped", action="store_true", help="Access the peripherals through runtime-mapped base addresses (Linux UIO or /dev/mem) instead of their absolute addresses.")
+backend_group.add_argument("--cosim", action="store_true", help="Access the peripherals in the shared register file of a device model in another process. Accesses to registers with side effects are forwarded to the model.")
+arg_parser.add_argument("--cache", choices=["write-through", "write-back"], default=None, help="Keep the registers that only change when written in a register cache, with the given write policy. Volatile registers can be listed in the overlay file.")
+arg_parser.add_argument("--trace", action="store_true", help="Record register indices instead of offsets in register access traces (TSRI_OPTION_TRACE). Traces are decoded with decode_trace.py.")
+arg_parser.add_argument("--names", action="store_true", help="Generate constexpr name tables of the registers, fields and enumerated values, used by tsri::registers::format.")
 args = arg_parser.parse_args()
 
 def get_peripheral_file(peripheral):
@@ -45,12 +56,15 @@ device = parser.get_device()
 ### Construct device representation that can be used in the templates ###
 peripherals = []
 if args.generate_only != []:
-    for peripheral in device.peripherals:
+    for index, peripheral in enumerate(device.peripherals):
         if peripheral.name.lower() in args.generate_only:
-            peripherals.append(helpers.parse_peripheral(peripheral))
+            peripherals.append(helpers.parse_peripheral(peripheral, index))
 else:
     peripherals = helpers.parse_peripherals(device)
 
+if args.overlay != "":
+    helpers.apply_overlay(peripherals, args.overlay)
+
 ### If we only list output files, list them and then exit ###
 if args.list_output_files:
     for i, peripheral in enumerate(peripherals):
@@ -71,7 +85,7 @@ elif not args.no_clear:
 ### Generate code for each peripheral and move into output folder ###
 for peripheral in peripherals:
     template = env.get_template("peripheral.jinja2")
-    output = template.render(peripheral=peripheral, namespace=args.namespace)
+    output = template.render(peripheral=peripheral, namespace=args.namespace, narrow_writes=args.narrow_writes, mapped=args.mapped, cosim=args.cosim, cache=args.cache, trace=args.trace, names=args.names)
     output = minify_source(output) if not args.pretty else output
 
     # This makes sure comments stay on their own line. This is done so the comments render correctly in the IDE.
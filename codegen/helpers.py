@@ -1,4 +1,5 @@
 import definitions as defs
+import json
 from typing import List
 from cmsis_svd.model import SVDField, SVDRegister, SVDDevice, SVDPeripheral
 
@@ -39,10 +40,10 @@ def get_fields_from_register(register: SVDRegister) -> List[defs.Field]:
 
         if fld.enum_values == []:
             if fld.access_type == defs.AccessType.SELF_CLEARING or fld.access_type == defs.AccessType.WRITE_CLEAR:
-                fld.enum_values.append(defs.EnumValue(name="ONE", description="", value="1"))
+                fld.enum_values.append(defs.EnumValue(name="ONE", description="", value="1", is_default=True))
             elif field.bit_width == 1 and defs.AccessType != defs.AccessType.READ_ONLY:
-                fld.enum_values.append(defs.EnumValue(name="ZERO", description="", value="0"))
-                fld.enum_values.append(defs.EnumValue(name="ONE", description="", value="1"))
+                fld.enum_values.append(defs.EnumValue(name="ZERO", description="", value="0", is_default=True))
+                fld.enum_values.append(defs.EnumValue(name="ONE", description="", value="1", is_default=True))
 
         fields.append(fld)
     return fields
@@ -56,6 +57,7 @@ def get_registers_from_peripheral(peripheral: SVDPeripheral) -> List[defs.Regist
             description=register.description if register.description is not None else "",
             base_address=peripheral.base_address,
             address_offset=register.address_offset,
+            size=register.size if register.size is not None else 32,
             value_on_reset=register.reset_value,
             supports_atomic_bit_operations= peripheral.name != "SIO",
             access_type=defs.AccessType.from_fields(fields),
@@ -64,22 +66,95 @@ def get_registers_from_peripheral(peripheral: SVDPeripheral) -> List[defs.Regist
         registers.append(reg)
     return registers
 
-def parse_peripheral(peripheral: SVDPeripheral):
+def parse_peripheral(peripheral: SVDPeripheral, index: int = 0):
     return defs.Peripheral(
         name=peripheral.name,
         description=peripheral.description if peripheral.description is not None else "",
         base_address=peripheral.base_address,
-        registers=get_registers_from_peripheral(peripheral)
+        registers=get_registers_from_peripheral(peripheral),
+        index=index
     )
 
 def parse_peripherals(device: SVDDevice) -> List[defs.Peripheral]:
     peripherals = []
-    for peripheral in device.peripherals:
+    for index, peripheral in enumerate(device.peripherals):
         periph = defs.Peripheral(
             name=peripheral.name,
             description=peripheral.description if peripheral.description is not None else "",
             base_address=peripheral.base_address,
-            registers=get_registers_from_peripheral(peripheral)
+            registers=get_registers_from_peripheral(peripheral),
+            index=index
         )
         peripherals.append(periph)
     return peripherals
+
+def apply_overlay(peripherals: List[defs.Peripheral], overlay_file: str):
+    """
+    Add the information from the overlay file that is not in the SVD file. The overlay is a JSON object with an entry
+    per peripheral name:
+
+    {
+        "TIMER": {
+            "composites": [
+                { "name": "TIME", "low": "TIMELR", "high": "TIMEHR", "read": "low_latches_high" },
+                { "name": "TIMERAW", "low": "TIMERAWL", "high": "TIMERAWH", "read": "high_low_high" }
+            ],
+            "volatile": ["TIMELR", "TIMEHR"]
+        },
+        "UART0": {
+            "endpoints": [
+                { "name": "TX", "register": "UARTDR", "dreq": 20 },
+                { "name": "RX", "register": "UARTDR", "dreq": 21 }
+            ]
+        }
+    }
+
+    Registers listed as "volatile" change without being written, or have side effects when they are read (e.g. FIFO data
+    registers). They are never kept in the register cache, and their accesses are forwarded to the device model when
+    co-simulating.
+
+    "endpoints" are the DMA endpoints of the peripheral: a register and the number of the data request (DREQ) signal that
+    paces transfers to or from it, from the DMA chapter of the datasheet. Each becomes a `tsri::dma::endpoint` with the
+    given name in the peripheral class.
+
+    Peripherals in the overlay that are not generated are skipped, so the same overlay can be used with `-g`.
+    """
+    with open(overlay_file) as f:
+        overlay = json.load(f)
+
+    for peripheral in peripherals:
+        peripheral_overlay = overlay.get(peripheral.name, {})
+        registers = {register.name: register for register in peripheral.registers}
+
+        for composite in peripheral_overlay.get("composites", []):
+            for half in ("low", "high"):
+                if composite[half] not in registers:
+                    raise ValueError(f"Composite {peripheral.name}.{composite['name']}: register {composite[half]} does not exist.")
+                if registers[composite[half]].access_type == defs.AccessType.WRITE_ONLY:
+                    raise ValueError(f"Composite {peripheral.name}.{composite['name']}: register {composite[half]} is not readable.")
+
+            peripheral.composites.append(defs.Composite(
+                name=composite["name"],
+                description=composite.get("description", ""),
+                low=registers[composite["low"]],
+                high=registers[composite["high"]],
+                read=defs.CompositeRead(composite["read"])
+            ))
+
+        for endpoint in peripheral_overlay.get("endpoints", []):
+            if endpoint["register"] not in registers:
+                raise ValueError(f"Endpoint {peripheral.name}.{endpoint['name']}: register {endpoint['register']} does not exist.")
+            if endpoint["name"] in registers or endpoint["name"] in (composite.name for composite in peripheral.composites):
+                raise ValueError(f"Endpoint {peripheral.name}.{endpoint['name']}: the name is already used by a register.")
+
+            peripheral.endpoints.append(defs.Endpoint(
+                name=endpoint["name"],
+                register=registers[endpoint["register"]],
+                dreq=int(endpoint["dreq"])
+            ))
+
+        for register_name in peripheral_overlay.get("volatile", []):
+            if register_name not in registers:
+                raise ValueError(f"Volatile register {peripheral.name}.{register_name} does not exist.")
+
+            registers[register_name].is_volatile = True
@@ -0,0 +1,195 @@
+"""
+This file reports which peripherals, registers and fields a firmware image uses, from the TSRI usage manifest (see
+`include/tsri/registers/usage_manifest.hpp`) in the final ELF file (elf_file). Build the image with
+`TSRI_OPTION_MANIFEST` defined.
+
+The report lists the call sites per peripheral, register and field, the registers with the most call sites (candidates
+for batching, e.g. with a register cache or an init table), and the functions that contain register code with their size
+in bytes, to audit the flash spent on register code.
+
+Register and field names are taken from the SVD file that the headers were generated from (svd_file). Without it, the
+register addresses are printed.
+
+With '--used-peripherals', only the lowercase names of the used peripherals are printed, separated by semicolons. This
+list can be passed to the generator with '-g', or to CMake with 'TSRI_GENERATE_ONLY', to generate only those peripherals.
+"""
+import bisect
+import shutil
+import struct
+import subprocess
+import sys
+from argparse import ArgumentParser
+from collections import Counter, defaultdict
+
+MANIFEST_SECTION = ".tsri_manifest"
+RECORD_SIZE = 32
+OPERATIONS = ["get", "get_fields", "test_bits", "wait", "dispatch", "acknowledge", "set", "reset", "set_fields",
+              "set_fields_overwrite", "clear_fields", "set_bits", "clear_bits", "toggle_bits", "sample"]
+SHT_SYMTAB = 2
+STT_FUNC = 2
+EM_ARM = 40
+
+### Parse command line arguments ###
+arg_parser = ArgumentParser(description="Report the register usage in a firmware image built with TSRI_OPTION_MANIFEST.")
+arg_parser.add_argument("elf_file", help="Path to the linked ELF file.")
+arg_parser.add_argument("svd_file", nargs="?", default="", help="Path to the SVD file that the headers were generated from.")
+arg_parser.add_argument("--top", type=int, default=10, help="Number of registers and functions in the hot lists. Default: 10.")
+arg_parser.add_argument("--used-peripherals", action="store_true", help="Only print the lowercase names of the used peripherals, separated by semicolons.")
+args = arg_parser.parse_args()
+
+if args.used_peripherals and args.svd_file == "":
+    sys.exit("'--used-peripherals' requires the SVD file.")
+
+### Read the ELF file ###
+with open(args.elf_file, "rb") as f:
+    elf = f.read()
+
+if elf[:4] != b"\x7fELF":
+    sys.exit(f"'{args.elf_file}' is not an ELF file.")
+
+is_64_bit = elf[4] == 2
+byte_order = "<" if elf[5] == 1 else ">"
+
+if is_64_bit:
+    _, machine, _, _, _, section_offset, _, _, _, _, section_size, section_count, names_index = struct.unpack_from(f"{byte_order}HHIQQQIHHHHHH", elf, 16)
+    section_format, symbol_format, address_format = f"{byte_order}IIQQQQIIQQ", f"{byte_order}IBBHQQ", "Q"
+else:
+    _, machine, _, _, _, section_offset, _, _, _, _, section_size, section_count, names_index = struct.unpack_from(f"{byte_order}HHIIIIIHHHHHH", elf, 16)
+    section_format, symbol_format, address_format = f"{byte_order}IIIIIIIIII", f"{byte_order}IIIBBH", "I"
+
+sections = [struct.unpack_from(section_format, elf, section_offset + index * section_size) for index in range(section_count)]
+
+def get_string(table_offset: int, offset: int) -> str:
+    """
+    Return the zero-terminated string at `offset` in the string table at `table_offset`.
+    """
+    start = table_offset + offset
+    return elf[start:elf.index(b"\0", start)].decode(errors="replace")
+
+section_names = [get_string(sections[names_index][4], section[0]) for section in sections]
+
+if MANIFEST_SECTION not in section_names:
+    sys.exit(f"'{args.elf_file}' has no {MANIFEST_SECTION} section. Was it built with TSRI_OPTION_MANIFEST?")
+
+_, _, _, _, manifest_offset, manifest_size, _, _, _, _ = sections[section_names.index(MANIFEST_SECTION)]
+
+records = []
+for offset in range(manifest_offset, manifest_offset + manifest_size - RECORD_SIZE + 1, RECORD_SIZE):
+    address_low, address_high, mask_low, mask_high, operation, size = struct.unpack_from(f"{byte_order}6I", elf, offset)
+    site, = struct.unpack_from(f"{byte_order}{address_format}", elf, offset + 24)
+    records.append(((address_high << 32) | address_low, (mask_high << 32) | mask_low, operation, size, site))
+
+### Read the functions from the symbol table ###
+functions = []
+for section in sections:
+    if section[1] != SHT_SYMTAB:
+        continue
+
+    names_offset = sections[section[6]][4]
+    for offset in range(section[4], section[4] + section[5], section[9]):
+        if is_64_bit:
+            name, info, _, _, value, size = struct.unpack_from(symbol_format, elf, offset)
+        else:
+            name, value, size, info, _, _ = struct.unpack_from(symbol_format, elf, offset)
+
+        if info & 0xF == STT_FUNC and size != 0:
+            # Thumb functions have the lowest bit of their address set.
+            start = value & ~1 if machine == EM_ARM else value
+            functions.append((start, size, get_string(names_offset, name)))
+
+functions.sort()
+function_starts = [function[0] for function in functions]
+
+def demangle(names: list) -> dict:
+    """
+    Return the demangled C++ names, if c++filt is available.
+    """
+    if shutil.which("c++filt") is None:
+        return {name: name for name in names}
+
+    result = subprocess.run(["c++filt"], input="\n".join(names), capture_output=True, text=True)
+    return dict(zip(names, result.stdout.splitlines()))
+
+def get_function(site: int):
+    """
+    Return the function that contains the call site, or None if it is in no function, e.g. because the linker removed it.
+    """
+    index = bisect.bisect_right(function_starts, site) - 1
+    if site == 0 or index < 0 or site >= functions[index][0] + functions[index][1]:
+        return None
+    return functions[index]
+
+### Construct the name tables ###
+registers = {}
+if args.svd_file != "":
+    from cmsis_svd import SVDParser
+    import helpers
+
+    device = SVDParser.for_xml_file(args.svd_file).get_device()
+    for peripheral in helpers.parse_peripherals(device):
+        for register in peripheral.registers:
+            registers.setdefault(peripheral.base_address + register.address_offset, (peripheral, register))
+
+def get_peripheral_name(address: int) -> str:
+    return registers[address][0].name if address in registers else "<unknown>"
+
+def get_register_name(address: int) -> str:
+    return registers[address][1].name if address in registers else f"0x{address:08X}"
+
+def get_field_names(address: int, mask: int) -> list:
+    """
+    Return the names of the fields of the register at `address` that overlap `mask`.
+    """
+    if address not in registers:
+        return []
+    return [field.name for field in registers[address][1].fields
+            if mask & (((1 << field.length_in_bits) - 1) << field.start_bit)]
+
+### Count the call sites ###
+live_records = [record for record in records if get_function(record[4]) is not None]
+removed_sites = len(records) - len(live_records)
+
+peripheral_sites = Counter()
+register_sites = defaultdict(Counter)
+field_sites = defaultdict(Counter)
+register_functions = defaultdict(set)
+function_sites = Counter()
+
+for address, mask, operation, _, site in live_records:
+    function = get_function(site)
+    peripheral_sites[get_peripheral_name(address)] += 1
+    register_sites[address][OPERATIONS[operation] if operation < len(OPERATIONS) else f"<operation {operation}>"] += 1
+    for field_name in get_field_names(address, mask):
+        field_sites[address][field_name] += 1
+    register_functions[address].add(function)
+    function_sites[function] += 1
+
+if args.used_peripherals:
+    print(";".join(sorted(name.lower() for name in peripheral_sites if name != "<unknown>")), end="")
+    sys.exit(0)
+
+### Print the report ###
+print(f"{len(live_records)} register call sites in {len(function_sites)} functions")
+if removed_sites != 0:
+    print(f"# {removed_sites} call sites in code that was removed by the linker are not counted")
+
+print("\nCall sites per peripheral, register and field:")
+for peripheral_name, count in peripheral_sites.most_common():
+    print(f"  {peripheral_name:<40} {count:>6}")
+    peripheral_registers = [address for address in register_sites if get_peripheral_name(address) == peripheral_name]
+    for address in sorted(peripheral_registers, key=lambda address: -sum(register_sites[address].values())):
+        operations = ", ".join(f"{name} {n}" for name, n in register_sites[address].most_common())
+        print(f"    {get_register_name(address):<38} {sum(register_sites[address].values()):>6}  {operations}")
+        for field_name, n in field_sites[address].most_common():
+            print(f"      {field_name:<36} {n:>6}")
+
+print("\nRegisters with the most call sites:")
+hot_registers = sorted(register_sites, key=lambda address: -sum(register_sites[address].values()))[:args.top]
+for rank, address in enumerate(hot_registers, 1):
+    name = f"{get_peripheral_name(address)}.{get_register_name(address)}" if address in registers else get_register_name(address)
+    print(f"  {rank:>3}. {name:<40} {sum(register_sites[address].values()):>6} call sites in {len(register_functions[address])} functions")
+
+print("\nFunctions with register code, largest first (bytes, call sites):")
+names = demangle([function[2] for function in function_sites])
+for function in sorted(function_sites, key=lambda function: -function[1])[:args.top]:
+    print(f"  {function[1]:>8}  {function_sites[function]:>6}  {names.get(function[2], function[2])}")
@@ -0,0 +1,106 @@
+/**
+ * @file frame_pool.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Fixed-size pool for coroutine frames.
+ * @version 0.1
+ * @date 2025-08-05
+ *
+ * Coroutine frames are normally allocated on the heap. Embedded targets often have no heap, so the frames of
+ * `async::task` coroutines are allocated from a static pool with a fixed number of fixed-size slots instead.
+ *
+ * The pool can be configured with the following macros:
+ * - `TSRI_OPTION_ASYNC_FRAME_SIZE`: size of a slot in bytes, must be a multiple of `alignof(std::max_align_t)`;
+ * - `TSRI_OPTION_ASYNC_FRAME_COUNT`: number of slots, at most 32.
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef TSRI_OPTION_ASYNC_FRAME_SIZE
+#define TSRI_OPTION_ASYNC_FRAME_SIZE 256U
+#endif
+
+#ifndef TSRI_OPTION_ASYNC_FRAME_COUNT
+#define TSRI_OPTION_ASYNC_FRAME_COUNT 8U
+#endif
+
+namespace tsri::async
+{
+
+/**
+ * @brief Pool of `SlotCount` slots of `SlotSize` bytes. The pool is not thread-safe: allocate and free frames from
+ * one context only, i.e. do not create tasks in interrupt handlers.
+ *
+ * @tparam SlotSize Size of a slot in bytes.
+ * @tparam SlotCount Number of slots.
+ */
+template<std::size_t SlotSize, std::size_t SlotCount>
+class frame_pool
+{
+public:
+    static_assert(SlotSize % alignof(std::max_align_t) == 0U, "Frame size must be a multiple of the max alignment.");
+    static_assert(SlotCount > 0U and SlotCount <= 32U, "Frame count must be between 1 and 32.");
+
+    frame_pool()                                     = delete;
+    frame_pool(frame_pool&&)                         = delete;
+    frame_pool(const frame_pool&)                    = delete;
+    auto operator=(frame_pool&&) -> frame_pool&      = delete;
+    auto operator=(const frame_pool&) -> frame_pool& = delete;
+    ~frame_pool()                                    = delete;
+
+    /**
+     * @brief Allocates a slot.
+     *
+     * @param size Size of the coroutine frame.
+     * @return void* Pointer to the slot, or `nullptr` if the frame does not fit or all slots are in use.
+     */
+    [[nodiscard]] static auto allocate(const std::size_t size) noexcept -> void*
+    {
+        const auto index = static_cast<std::size_t>(std::countr_one(used_slots));
+
+        if (size > SlotSize or index >= SlotCount)
+        {
+            return nullptr;
+        }
+
+        used_slots |= std::uint32_t{ 1U } << index;
+
+        return &storage[index * SlotSize];
+    }
+
+    /**
+     * @brief Frees a slot that was returned by `allocate()`.
+     *
+     * @param frame Pointer to the slot.
+     */
+    static void deallocate(void* const frame) noexcept
+    {
+        const auto index = static_cast<std::size_t>(static_cast<std::byte*>(frame) - storage.data()) / SlotSize;
+
+        used_slots &= ~(std::uint32_t{ 1U } << index);
+    }
+
+    /**
+     * @brief Returns the number of slots that are in use.
+     *
+     * @return std::size_t Number of used slots.
+     */
+    [[nodiscard]] static auto get_used_slot_count() noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(std::popcount(used_slots));
+    }
+
+private:
+    /* Memory of all slots. */
+    alignas(std::max_align_t) static inline std::array<std::byte, SlotSize * SlotCount> storage{};
+    /* Bit N is set if slot N is in use. */
+    static inline std::uint32_t used_slots = 0U;
+};
+
+/* Pool used for the frames of `async::task` coroutines. */
+using task_frame_pool = frame_pool<TSRI_OPTION_ASYNC_FRAME_SIZE, TSRI_OPTION_ASYNC_FRAME_COUNT>;
+
+}  // namespace tsri::async
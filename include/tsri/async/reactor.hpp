@@ -0,0 +1,252 @@
+/**
+ * @file reactor.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Handling Linux UIO interrupts in an epoll event loop.
+ * @version 0.1
+ * @date 2025-08-09
+ *
+ * A UIO device signals interrupts through its file descriptor: a read blocks until the next interrupt, and writing 1
+ * re-enables the interrupt. Instead of a thread per device that blocks on `read`, the file descriptors are added to an
+ * epoll reactor, and the interrupt of a peripheral is handled when its descriptor becomes readable:
+ * @code
+ * void on_interrupt(const auto& status) noexcept { ... status.template get<PERIPH::INTR::RX>() ... }
+ *
+ * tsri::async::register_interrupt<PERIPH::INTR, &on_interrupt, PERIPH::INTR::RX, PERIPH::INTR::TX> interrupt{ fd };
+ * tsri::async::reactor                                                                        reactor;
+ *
+ * static_cast<void>(reactor.add(interrupt));
+ * reactor.run();
+ * @endcode
+ *
+ * Handling an interrupt reads the status register once and acknowledges the write-clear bits that were read with one
+ * store (see `read_and_acknowledge`), re-enables the interrupt, and then calls the handler with the values that were
+ * read. Applications with their own epoll loop add `file_descriptor()` to it and call `handle()` when it is readable.
+ *
+ * An `eventfd` can be used in place of a UIO device, e.g. in tests: writing to it raises the interrupt.
+ */
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <concepts>
+#include <cstdint>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "../utility/type_map.hpp"
+
+namespace tsri::async
+{
+
+/**
+ * @brief File descriptor that signals the interrupts of a peripheral. The reactor keeps a pointer to the source, so it
+ * must stay at the same address while it is added.
+ */
+class interrupt_source
+{
+public:
+    /**
+     * @brief Kind of file descriptor, which decides how interrupts are consumed and re-enabled.
+     */
+    enum class kind : std::uint8_t
+    {
+        /* UIO device: reads return a 32-bit interrupt count, writing 1 re-enables the interrupt. */
+        uio,
+        /* eventfd: reads return a 64-bit counter, there is nothing to re-enable. */
+        event
+    };
+
+    interrupt_source(interrupt_source&&)                         = delete;
+    interrupt_source(const interrupt_source&)                    = delete;
+    auto operator=(interrupt_source&&) -> interrupt_source&      = delete;
+    auto operator=(const interrupt_source&) -> interrupt_source& = delete;
+    ~interrupt_source()                                          = default;
+
+    /**
+     * @brief Returns the file descriptor, which becomes readable when an interrupt is pending.
+     */
+    [[nodiscard]] auto file_descriptor() const noexcept -> int
+    {
+        return descriptor;
+    }
+
+    /**
+     * @brief Consumes the pending interrupt and handles it. Call this when the file descriptor is readable.
+     */
+    void handle() noexcept
+    {
+        if (descriptor_kind == kind::uio)
+        {
+            std::int32_t count = 0;
+
+            static_cast<void>(::read(descriptor, &count, sizeof(count)));
+        }
+        else
+        {
+            std::uint64_t count = 0U;
+
+            static_cast<void>(::read(descriptor, &count, sizeof(count)));
+        }
+
+        handle_function(*this);
+    }
+
+protected:
+    /* Acknowledges and handles the interrupt, and re-enables it with `enable()`. */
+    using handle_function_t = void (*)(interrupt_source& source) noexcept;
+
+    interrupt_source(const int file_descriptor, const kind source_kind, const handle_function_t function) noexcept :
+        descriptor{ file_descriptor },
+        descriptor_kind{ source_kind },
+        handle_function{ function }
+    {}
+
+    /**
+     * @brief Re-enables the interrupt, after its status bits have been acknowledged.
+     */
+    void enable() const noexcept
+    {
+        if (descriptor_kind == kind::uio)
+        {
+            static constexpr std::int32_t enable_value = 1;
+
+            static_cast<void>(::write(descriptor, &enable_value, sizeof(enable_value)));
+        }
+    }
+
+private:
+    int               descriptor;
+    kind              descriptor_kind;
+    handle_function_t handle_function;
+};
+
+/**
+ * @brief Interrupt of a peripheral whose status is in `Register`. Each interrupt, the values of `Fields` are read and
+ * the write-clear bits among them are acknowledged in one store. The handler is called with the values that were read.
+ *
+ * @tparam Register Interrupt status register.
+ * @tparam Handler Function that takes the values of `Fields` (`const utility::types::type_map<Fields...>&`).
+ * @tparam Fields Fields of the status register, at least one of which is write-clear.
+ */
+template<typename Register, auto Handler, typename... Fields>
+    requires std::invocable<decltype(Handler), const utility::types::type_map<Fields...>&> and
+             requires { Register::template read_and_acknowledge<Fields...>(); }
+class register_interrupt : public interrupt_source
+{
+public:
+    /**
+     * @brief Creates the interrupt of a UIO device, or of an eventfd that stands in for one.
+     *
+     * @param file_descriptor Open file descriptor, stays owned by the caller.
+     * @param source_kind Kind of file descriptor.
+     */
+    explicit register_interrupt(const int file_descriptor, const kind source_kind = kind::uio) noexcept :
+        interrupt_source{ file_descriptor, source_kind, &acknowledge_and_handle }
+    {}
+
+private:
+    static void acknowledge_and_handle(interrupt_source& source) noexcept
+    {
+        const auto status = Register::template read_and_acknowledge<Fields...>();
+
+        static_cast<register_interrupt&>(source).enable();
+
+        Handler(status);
+    }
+};
+
+/**
+ * @brief Waits on the file descriptors of interrupt sources with epoll, and handles them when they are readable.
+ * Not thread-safe: add sources and call `poll()` from the same thread.
+ */
+class reactor
+{
+public:
+    reactor() noexcept :
+        epoll_descriptor{ ::epoll_create1(EPOLL_CLOEXEC) }
+    {}
+
+    reactor(reactor&&)                         = delete;
+    reactor(const reactor&)                    = delete;
+    auto operator=(reactor&&) -> reactor&      = delete;
+    auto operator=(const reactor&) -> reactor& = delete;
+
+    ~reactor()
+    {
+        if (epoll_descriptor >= 0)
+        {
+            ::close(epoll_descriptor);
+        }
+    }
+
+    /**
+     * @brief Checks if the epoll instance was created.
+     */
+    [[nodiscard]] auto is_valid() const noexcept -> bool
+    {
+        return epoll_descriptor >= 0;
+    }
+
+    /**
+     * @brief Starts waiting on the interrupts of `source`.
+     *
+     * @param source Interrupt source.
+     * @return true The source was added.
+     * @return false The source could not be added, `errno` tells why.
+     */
+    [[nodiscard]] auto add(interrupt_source& source) noexcept -> bool
+    {
+        epoll_event event{ .events = EPOLLIN, .data = { .ptr = &source } };
+
+        return ::epoll_ctl(epoll_descriptor, EPOLL_CTL_ADD, source.file_descriptor(), &event) == 0;
+    }
+
+    /**
+     * @brief Stops waiting on the interrupts of `source`.
+     *
+     * @param source Interrupt source.
+     * @return true The source was removed.
+     * @return false The source could not be removed, `errno` tells why.
+     */
+    auto remove(interrupt_source& source) noexcept -> bool
+    {
+        return ::epoll_ctl(epoll_descriptor, EPOLL_CTL_DEL, source.file_descriptor(), nullptr) == 0;
+    }
+
+    /**
+     * @brief Waits for interrupts and handles all sources that are pending.
+     *
+     * @tparam MaxEvents Maximum number of sources that are handled per call.
+     * @param timeout_ms Time to wait in milliseconds, -1 to wait forever and 0 to not wait.
+     * @return int Number of sources that were handled, or -1 on error.
+     */
+    template<int MaxEvents = 8>
+    auto poll(const int timeout_ms = -1) noexcept -> int
+    {
+        std::array<epoll_event, MaxEvents> events{};
+
+        const int count = ::epoll_wait(epoll_descriptor, events.data(), MaxEvents, timeout_ms);
+
+        for (int index = 0; index < count; index++)
+        {
+            static_cast<interrupt_source*>(events[index].data.ptr)->handle();
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Handles interrupts until waiting fails, e.g. because the epoll instance is invalid.
+     */
+    void run() noexcept
+    {
+        while (poll() >= 0 or errno == EINTR)
+        {}
+    }
+
+private:
+    int epoll_descriptor;
+};
+
+}  // namespace tsri::async
@@ -0,0 +1,85 @@
+/**
+ * @file register_condition.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Awaitable condition on the value of a register.
+ * @version 0.1
+ * @date 2025-08-05
+ *
+ * Register conditions are created by the `until*` functions of readable registers and can be awaited in tasks:
+ * @code
+ * const auto value = co_await PERIPH::STATUS::until(PERIPH::STATUS::READY::value::one);
+ * @endcode
+ *
+ * The result of `co_await` is the register value that satisfied the condition. Every readable register includes this
+ * header, so it does not include `<coroutine>`: only tasks and the scheduler need it, see `async/scheduler.hpp`.
+ */
+#pragma once
+
+#include "../utility/types.hpp"
+
+namespace tsri::async
+{
+
+/**
+ * @brief Condition `((register & mask) == expected) == is_equal` on the value of a register.
+ * The condition is also the node in the scheduler's list of pending conditions, so awaiting it does not allocate.
+ */
+struct register_condition
+{
+    /* Function that reads the register. */
+    using read_function_t = auto (*)() noexcept -> utility::types::register_value_t;
+
+    /* Address of the register. Conditions on the same register share one read per scheduler tick. */
+    utility::types::register_address_t address;
+    /* Reads the register. */
+    read_function_t read;
+    /* Bits of the register that are compared. */
+    utility::types::register_value_t mask;
+    /* Expected value of the compared bits. */
+    utility::types::register_value_t expected;
+    /* `true` if the bits must equal `expected`, `false` if they must differ from it. */
+    bool is_equal;
+
+    /* Register value that satisfied the condition. */
+    utility::types::register_value_t value = 0U;
+    /* Next pending condition of the scheduler. */
+    register_condition* next = nullptr;
+    /* Address of the coroutine that awaits the condition, see `std::coroutine_handle<>::address()`. */
+    void* awaiter = nullptr;
+
+    /**
+     * @brief Checks the condition against a register value.
+     *
+     * @param register_value Register value.
+     * @return true The condition is satisfied.
+     * @return false The condition is not satisfied.
+     */
+    [[nodiscard]] constexpr auto is_satisfied_by(const utility::types::register_value_t register_value) const noexcept
+        -> bool
+    {
+        return ((register_value & mask) == expected) == is_equal;
+    }
+
+    /* If the condition already holds, the task continues without being suspended. */
+    [[nodiscard]] auto await_ready() noexcept -> bool
+    {
+        value = read();
+
+        return is_satisfied_by(value);
+    }
+
+    /* Queues the condition on the scheduler of the task. `Coroutine` is the `std::coroutine_handle` of the task. */
+    template<typename Coroutine>
+    void await_suspend(const Coroutine coroutine) noexcept
+    {
+        awaiter = coroutine.address();
+        coroutine.promise().owner->enqueue(*this);
+    }
+
+    [[nodiscard]] auto await_resume() const noexcept -> utility::types::register_value_t
+    {
+        return value;
+    }
+};
+
+}  // namespace tsri::async
@@ -0,0 +1,165 @@
+/**
+ * @file scheduler.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Cooperative scheduler for tasks that wait on register conditions.
+ * @version 0.1
+ * @date 2025-08-05
+ *
+ * Instead of one superloop that polls every peripheral, each peripheral gets its own task that awaits the register
+ * conditions it needs. The scheduler checks all pending conditions once per tick:
+ * @code
+ * tsri::async::scheduler scheduler;
+ *
+ * static_cast<void>(scheduler.spawn(uart_receive()));
+ * static_cast<void>(scheduler.spawn(adc_sample()));
+ *
+ * scheduler.run<tsri::polling::backoff::wait_for_interrupt>();
+ * @endcode
+ *
+ * Pending conditions are kept sorted by register address, so conditions on the same register are next to each other
+ * and each distinct register is read only once per tick. The scheduler does not allocate: the conditions live in the
+ * frames of the tasks that await them, and the frames come from the `async::task_frame_pool`.
+ */
+#pragma once
+
+#include <coroutine>
+#include <utility>
+
+#include "../polling/polling.hpp"
+#include "register_condition.hpp"
+#include "task.hpp"
+
+namespace tsri::async
+{
+
+/**
+ * @brief Runs tasks until the register conditions they await are satisfied. Not thread-safe: spawn tasks and call
+ * `tick()` from the same context.
+ */
+class scheduler
+{
+public:
+    scheduler() noexcept                           = default;
+    scheduler(scheduler&&)                         = delete;
+    scheduler(const scheduler&)                    = delete;
+    auto operator=(scheduler&&) -> scheduler&      = delete;
+    auto operator=(const scheduler&) -> scheduler& = delete;
+    ~scheduler()                                   = default;
+
+    /**
+     * @brief Starts a task. It runs until it awaits its first unsatisfied condition, or until it finishes.
+     *
+     * @param new_task Task to start.
+     * @return true The task was started.
+     * @return false The task could not be started, because its frame could not be allocated.
+     */
+    [[nodiscard]] auto spawn(task&& new_task) noexcept -> bool
+    {
+        if (!new_task.is_valid())
+        {
+            return false;
+        }
+
+        const auto coroutine = new_task.release();
+
+        coroutine.promise().owner = this;
+        coroutine.resume();
+
+        return true;
+    }
+
+    /**
+     * @brief Reads each register with pending conditions once, and resumes the tasks whose condition is satisfied.
+     * Conditions that are awaited by the resumed tasks are checked in the next tick.
+     *
+     * @return true There are still pending conditions.
+     * @return false All tasks have finished.
+     */
+    auto tick() noexcept -> bool
+    {
+        register_condition* condition = std::exchange(pending, nullptr);
+
+        /* Last register that was read. Kept in locals, because resuming a task can destroy its condition. */
+        bool                               is_value_read = false;
+        utility::types::register_address_t address       = 0U;
+        utility::types::register_value_t   value         = 0U;
+
+        while (condition != nullptr)
+        {
+            register_condition* const next = condition->next;
+
+            if (!is_value_read or condition->address != address)
+            {
+                is_value_read = true;
+                address       = condition->address;
+                value         = condition->read();
+            }
+
+            if (condition->is_satisfied_by(value))
+            {
+                condition->value = value;
+                std::coroutine_handle<>::from_address(condition->awaiter).resume();
+            }
+            else
+            {
+                enqueue(*condition);
+            }
+
+            condition = next;
+        }
+
+        return !is_idle();
+    }
+
+    /**
+     * @brief Calls `tick()` until all tasks have finished.
+     *
+     * @tparam Backoff What to do between two ticks, see `polling::backoff`.
+     */
+    template<typename Backoff = polling::backoff::none>
+    void run() noexcept
+    {
+        while (tick())
+        {
+            Backoff::wait();
+        }
+    }
+
+    /**
+     * @brief Checks if no task is waiting on a condition.
+     *
+     * @return true No conditions are pending.
+     * @return false At least one condition is pending.
+     */
+    [[nodiscard]] auto is_idle() const noexcept -> bool
+    {
+        return pending == nullptr;
+    }
+
+private:
+    friend struct register_condition;
+
+    /**
+     * @brief Inserts a condition into the list of pending conditions, after the conditions with the same or a lower
+     * register address.
+     *
+     * @param condition Condition to insert.
+     */
+    void enqueue(register_condition& condition) noexcept
+    {
+        register_condition** position = &pending;
+
+        while (*position != nullptr and (*position)->address <= condition.address)
+        {
+            position = &(*position)->next;
+        }
+
+        condition.next = *position;
+        *position      = &condition;
+    }
+
+    /* Pending conditions, sorted by register address. */
+    register_condition* pending = nullptr;
+};
+
+}  // namespace tsri::async
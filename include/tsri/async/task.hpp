@@ -0,0 +1,157 @@
+/**
+ * @file task.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Coroutine type for tasks that wait on register conditions.
+ * @version 0.1
+ * @date 2025-08-05
+ *
+ * A task is a coroutine that returns `async::task`:
+ * @code
+ * auto uart_receive() -> tsri::async::task
+ * {
+ *     for (;;)
+ *     {
+ *         co_await UART::FR::until_all_bits_cleared(UART::FR::RXFE{});
+ *         // ...
+ *     }
+ * }
+ * @endcode
+ *
+ * Tasks do not run until they are spawned on a scheduler, see `async::scheduler`. Their frames are allocated from the
+ * `async::task_frame_pool`, never from the heap.
+ */
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+#include "frame_pool.hpp"
+
+namespace tsri::async
+{
+
+class scheduler;
+
+/**
+ * @brief Handle to a task coroutine that has not been spawned yet.
+ * If the frame pool is exhausted, the task is invalid and spawning it fails.
+ */
+class task
+{
+public:
+    /**
+     * @brief Promise of a task coroutine.
+     */
+    struct promise_type
+    {
+        /* Scheduler the task was spawned on. Register conditions awaited by the task are queued on this scheduler. */
+        scheduler* owner = nullptr;
+
+        [[nodiscard]] static auto operator new(const std::size_t size) noexcept -> void*
+        {
+            return task_frame_pool::allocate(size);
+        }
+
+        static void operator delete(void* const frame) noexcept
+        {
+            task_frame_pool::deallocate(frame);
+        }
+
+        [[nodiscard]] static auto get_return_object_on_allocation_failure() noexcept -> task
+        {
+            return task{};
+        }
+
+        [[nodiscard]] auto get_return_object() noexcept -> task
+        {
+            return task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+        }
+
+        /* Tasks start when they are spawned. */
+        [[nodiscard]] static auto initial_suspend() noexcept -> std::suspend_always
+        {
+            return {};
+        }
+
+        /* The frame is freed as soon as the task finishes. */
+        [[nodiscard]] static auto final_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+
+        static void return_void() noexcept {}
+
+        [[noreturn]] static void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+
+    task(const task&)                    = delete;
+    auto operator=(const task&) -> task& = delete;
+
+    task(task&& other) noexcept : handle{ std::exchange(other.handle, nullptr) } {}
+
+    auto operator=(task&& other) noexcept -> task&
+    {
+        if (this != &other)
+        {
+            destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~task()
+    {
+        destroy();
+    }
+
+    /**
+     * @brief Checks if the task has a coroutine frame, i.e. if the frame allocation succeeded and the task has not been
+     * spawned yet.
+     *
+     * @return true The task can be spawned.
+     * @return false The task can not be spawned.
+     */
+    [[nodiscard]] auto is_valid() const noexcept -> bool
+    {
+        return static_cast<bool>(handle);
+    }
+
+private:
+    friend class scheduler;
+
+    task() noexcept = default;
+
+    explicit task(const std::coroutine_handle<promise_type> coroutine) noexcept : handle{ coroutine } {}
+
+    /**
+     * @brief Gives up ownership of the coroutine, after which the scheduler owns it.
+     *
+     * @return std::coroutine_handle<promise_type> Handle to the coroutine.
+     */
+    [[nodiscard]] auto release() noexcept -> std::coroutine_handle<promise_type>
+    {
+        return std::exchange(handle, nullptr);
+    }
+
+    /**
+     * @brief Destroys the coroutine if it was never spawned.
+     */
+    void destroy() noexcept
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+    /* Coroutine of the task, `nullptr` if invalid or spawned. */
+    std::coroutine_handle<promise_type> handle = nullptr;
+};
+
+}  // namespace tsri::async
@@ -0,0 +1,118 @@
+/**
+ * @file backend.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Selection of the backend that performs the register accesses.
+ * @version 0.1
+ * @date 2025-08-05
+ *
+ * Registers do not access memory themselves, they go through a backend. A backend is a class with static functions:
+ * - `read<PeripheralBaseAddress, Access>(offset)`: returns the value of the register at `offset` from the peripheral
+ *   base;
+ * - `write<PeripheralBaseAddress, WriteType, Access>(offset, value)`: writes `value` to the register at `offset`, or to
+ *   one of its atomic aliases depending on `WriteType`.
+ *
+ * `Access` is an unsigned type with the width of the register (8, 16, 32 or 64 bits), and defaults to
+ * `utility::types::register_value_t`. Backends must access the register with exactly this width.
+ *
+ * Backends that can hand out a pointer to the peripheral may additionally provide
+ * `base_pointer<PeripheralBaseAddress>()`, which is used by the peripheral view to access multiple registers through a
+ * single base pointer.
+ *
+ * Backends that can modify a register atomically may additionally provide
+ * `modify<PeripheralBaseAddress, Access>(offset, clear_mask, set_value)` and
+ * `toggle<PeripheralBaseAddress, Access>(offset, toggle_mask, clear_mask)`. The read-modify-writes of the registers then
+ * call these instead of a separate read and write, with the write-clear bits of the register in `clear_mask`. Such
+ * backends also perform the atomic writes of the registers, unless they provide
+ * `has_atomic_aliases<PeripheralBaseAddress>()` and it returns `true`, see `mapped.hpp`.
+ *
+ * Backends where each access is a transaction may additionally provide
+ * `read_burst<PeripheralBaseAddress, Access>(offset, values)` and `write_burst<PeripheralBaseAddress, Access>(offset,
+ * values)`, which access consecutive registers in one transaction. Operations on multiple registers then coalesce
+ * their accesses, see `transport.hpp`.
+ *
+ * The backend of a peripheral is `peripheral_backend<PeripheralBaseAddress>::type`. By default, this is the
+ * memory-mapped backend. Defining `TSRI_OPTION_BACKEND_SIMULATOR` changes the default to the host simulator. The backend
+ * of a single peripheral can be changed by specializing `peripheral_backend`, e.g. to the mapped backend on Linux, or
+ * to the co-simulation backend to run against a device model in another process. These backends need Linux system
+ * headers, so they are only included with `TSRI_OPTION_BACKEND_MAPPED` or `TSRI_OPTION_BACKEND_COSIM`, or by including
+ * `mapped.hpp` or `cosim.hpp` directly. Headers generated with `--mapped` or `--cosim` include them.
+ */
+#pragma once
+
+#include <concepts>
+#include <type_traits>
+
+#include "../utility/types.hpp"
+#include "bus.hpp"
+#include "cached.hpp"
+#include "mmio.hpp"
+#include "traced.hpp"
+#include "transport.hpp"
+#include "write_type.hpp"
+
+#ifdef TSRI_OPTION_BACKEND_SIMULATOR
+#include "simulator.hpp"
+#endif
+
+#ifdef TSRI_OPTION_BACKEND_MAPPED
+#include "mapped.hpp"
+#endif
+
+#ifdef TSRI_OPTION_BACKEND_COSIM
+#include "cosim.hpp"
+#endif
+
+namespace tsri::backends
+{
+
+/**
+ * @brief Checks if `Backend` implements the backend functions for the peripheral at address 0.
+ */
+template<typename Backend>
+concept backend = requires(utility::types::register_address_t offset, utility::types::register_value_t value) {
+    { Backend::template read<0U>(offset) } -> std::same_as<utility::types::register_value_t>;
+    Backend::template write<0U, write_type::normal>(offset, value);
+};
+
+/* Backend that is used for peripherals without a specialization of `peripheral_backend`. */
+#ifdef TSRI_OPTION_BACKEND_SIMULATOR
+using default_backend = simulator;
+#else
+using default_backend = mmio;
+#endif
+
+/**
+ * @brief Selects the backend of the peripheral at `PeripheralBaseAddress`. Specialize this to use a different
+ * backend for a peripheral.
+ *
+ * @tparam PeripheralBaseAddress Base address of the peripheral.
+ */
+template<utility::types::register_address_t PeripheralBaseAddress>
+struct peripheral_backend
+{
+    using type = default_backend;
+};
+
+/**
+ * @brief Backend of the peripheral at `PeripheralBaseAddress` that reaches the bus. With `TSRI_OPTION_TRACE`, its
+ * accesses are recorded in the trace buffer, see `traced.hpp`.
+ */
+#ifdef TSRI_OPTION_TRACE
+template<utility::types::register_address_t PeripheralBaseAddress>
+using bus_backend_t = traced<typename peripheral_backend<PeripheralBaseAddress>::type>;
+#else
+template<utility::types::register_address_t PeripheralBaseAddress>
+using bus_backend_t = typename peripheral_backend<PeripheralBaseAddress>::type;
+#endif
+
+/**
+ * @brief Backend of the peripheral at `PeripheralBaseAddress`. Peripherals with cached registers access them through
+ * the register cache, see `register_cache_map`.
+ */
+template<utility::types::register_address_t PeripheralBaseAddress>
+using backend_t = std::conditional_t<
+    register_cache_map<PeripheralBaseAddress>::registers.empty(),
+    bus_backend_t<PeripheralBaseAddress>,
+    cached<bus_backend_t<PeripheralBaseAddress>>>;
+
+}  // namespace tsri::backends
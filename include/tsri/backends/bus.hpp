@@ -0,0 +1,41 @@
+/**
+ * @file bus.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Properties of the bus that a peripheral is connected to.
+ * @version 0.1
+ * @date 2025-08-08
+ *
+ * Not every bus handles byte and halfword writes the same way. Some buses write only the addressed lane, others
+ * replicate the narrow value over the whole word (e.g. the APB peripherals of the RP2040). The device profile tells the
+ * registers which of the two they are dealing with, so narrow stores are only used where they are safe.
+ *
+ * By default, no bus supports narrow writes. Defining `TSRI_OPTION_NARROW_WRITES` marks all buses of the device as
+ * supporting them. Single peripherals can be marked by specializing `peripheral_bus`, which the code generator does
+ * when it is given `--narrow-writes`.
+ */
+#pragma once
+
+#include "../utility/types.hpp"
+
+namespace tsri::backends
+{
+
+/**
+ * @brief Device profile of the bus of the peripheral at `PeripheralBaseAddress`. Specialize this to change the
+ * profile of a single peripheral.
+ *
+ * @tparam PeripheralBaseAddress Base address of the peripheral.
+ */
+template<utility::types::register_address_t PeripheralBaseAddress>
+struct peripheral_bus
+{
+#ifdef TSRI_OPTION_NARROW_WRITES
+    /* Whether byte and halfword writes only change the addressed lane of a register. */
+    static constexpr bool supports_narrow_writes = true;
+#else
+    /* Whether byte and halfword writes only change the addressed lane of a register. */
+    static constexpr bool supports_narrow_writes = false;
+#endif
+};
+
+}  // namespace tsri::backends
@@ -0,0 +1,381 @@
+/**
+ * @file cached.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Register cache for peripherals with slow or write-only registers.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * The cache keeps a copy of the registers that only change when they are written, i.e. registers that hold
+ * configuration. Status registers, data registers and registers with self-clearing or write-clear fields are volatile
+ * and are never cached. The cached registers of a peripheral are listed in its `register_cache_map`, which the code
+ * generator emits with `--cache` from the access types in the SVD file and the volatile registers in the overlay file.
+ * Peripherals with a cache map use the `cached` backend on top of their own backend.
+ *
+ * Reads of cached registers are served from RAM after the first read. Writes that do not change the cached value are
+ * left out. What happens to the other writes depends on the cache policy:
+ * - `write_through`: the register is written immediately. This suits memory-mapped peripherals, where the cache is
+ *   mostly used as a shadow copy of write-only registers: their fields can be set with `set_fields` without a read.
+ * - `write_back`: only the cache is written and the register is marked dirty. `sync()` of the peripheral writes all
+ *   dirty registers in address order, in bursts if the backend supports them (see `transport.hpp`). This suits devices
+ *   on slow buses.
+ *
+ * Write-only registers are cached with their reset value. Writes to the atomic aliases are always performed
+ * immediately, after writing back the register if it is dirty.
+ *
+ * The cache is not thread-safe. Init tables write the absolute register addresses and bypass the cache.
+ */
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+#include "write_type.hpp"
+
+namespace tsri::backends
+{
+
+/**
+ * @brief When writes to cached registers reach the register.
+ */
+enum class cache_policy : std::uint8_t
+{
+    /* Every write that changes the cached value is performed immediately. */
+    write_through,
+    /* Writes only change the cache, until `sync()` writes the dirty registers. */
+    write_back
+};
+
+/**
+ * @brief Register in the cache map of a peripheral.
+ */
+struct cached_register
+{
+    /* Offset of the register from the peripheral base address. */
+    utility::types::register_address_t offset;
+    /* Size of the register in bits, at most 32. */
+    utility::types::register_size_t size;
+    /* Value of the register after reset. */
+    utility::types::register_value_t value_on_reset;
+    /* Whether the register can be read. Registers that can not are cached with their reset value. */
+    bool is_readable;
+};
+
+/**
+ * @brief Cached registers of the peripheral at `PeripheralBaseAddress`, in ascending order of their offsets. By default
+ * no registers are cached. Specialize this, or generate it with `--cache`, to cache registers of a peripheral.
+ *
+ * @tparam PeripheralBaseAddress Base address of the peripheral.
+ */
+template<utility::types::register_address_t PeripheralBaseAddress>
+struct register_cache_map
+{
+    /* When writes reach the registers. */
+    static constexpr cache_policy policy = cache_policy::write_through;
+
+    /* Cached registers. */
+    static constexpr std::array<cached_register, 0U> registers{};
+};
+
+/**
+ * @brief Keeps a copy of the registers in the cache map of a peripheral, and accesses the registers through `Backend`.
+ *
+ * @tparam Backend Backend that performs the register accesses.
+ */
+template<typename Backend>
+class cached
+{
+private:
+    /* Index of registers that are not cached. */
+    static constexpr std::size_t not_cached = SIZE_MAX;
+
+    /**
+     * @brief Returns the index of the register at `offset` in the cache map, or `not_cached`.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    [[nodiscard]] TSRI_INLINE static constexpr auto get_index(const utility::types::register_address_t offset) noexcept
+        -> std::size_t
+    {
+        constexpr const auto& map = register_cache_map<PeripheralBaseAddress>::registers;
+
+        for (std::size_t index = 0U; index < map.size(); index++)
+        {
+            if (map[index].offset == offset)
+            {
+                return index;
+            }
+        }
+
+        return not_cached;
+    }
+
+public:
+    cached()                                 = delete;
+    cached(cached&&)                         = delete;
+    cached(const cached&)                    = delete;
+    auto operator=(cached&&) -> cached&      = delete;
+    auto operator=(const cached&) -> cached& = delete;
+    ~cached()                                = delete;
+
+    /**
+     * @brief `true` if the register at `Offset` of the peripheral at `PeripheralBaseAddress` is cached.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress, utility::types::register_address_t Offset>
+    static constexpr bool caches = get_index<PeripheralBaseAddress>(Offset) != not_cached;
+
+    /**
+     * @brief Reads the register at `offset` from the peripheral base address, from the cache if it is cached.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @return Access Register value.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    [[nodiscard]] TSRI_INLINE static auto read(const utility::types::register_address_t offset) -> Access
+    {
+        const std::size_t index = get_index<PeripheralBaseAddress>(offset);
+
+        if (index == not_cached)
+        {
+            return Backend::template read<PeripheralBaseAddress, Access>(offset);
+        }
+
+        auto& entry = entries<PeripheralBaseAddress>[index];
+
+        if (!entry.is_valid)
+        {
+            entry.value    = Backend::template read<PeripheralBaseAddress, Access>(offset);
+            entry.is_valid = true;
+        }
+
+        return static_cast<Access>(entry.value);
+    }
+
+    /**
+     * @brief Writes the register at `offset` from the peripheral base address, or one of its atomic aliases. Writes to
+     * cached registers that do not change the cached value are left out.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam WriteType Type of the write.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param value Value to write.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        write_type                         WriteType = write_type::normal,
+        std::unsigned_integral             Access    = utility::types::register_value_t>
+    TSRI_INLINE static void write(const utility::types::register_address_t offset, const Access value)
+    {
+        const std::size_t index = get_index<PeripheralBaseAddress>(offset);
+
+        if (index == not_cached)
+        {
+            Backend::template write<PeripheralBaseAddress, WriteType, Access>(offset, value);
+
+            return;
+        }
+
+        auto& entry = entries<PeripheralBaseAddress>[index];
+
+        if constexpr (WriteType == write_type::normal)
+        {
+            if (entry.is_valid and entry.value == value)
+            {
+                return;
+            }
+
+            entry.value    = value;
+            entry.is_valid = true;
+
+            if constexpr (register_cache_map<PeripheralBaseAddress>::policy == cache_policy::write_back)
+            {
+                entry.is_dirty = true;
+            }
+            else
+            {
+                Backend::template write<PeripheralBaseAddress, write_type::normal, Access>(offset, value);
+            }
+        }
+        else
+        {
+            if (entry.is_dirty)
+            {
+                Backend::template write<PeripheralBaseAddress, write_type::normal, Access>(
+                    offset, static_cast<Access>(entry.value));
+                entry.is_dirty = false;
+            }
+
+            Backend::template write<PeripheralBaseAddress, WriteType, Access>(offset, value);
+
+            if constexpr (WriteType == write_type::atomic_xor)
+            {
+                entry.value ^= value;
+            }
+            else if constexpr (WriteType == write_type::atomic_set)
+            {
+                entry.value |= value;
+            }
+            else
+            {
+                entry.value &= ~static_cast<utility::types::register_value_t>(value);
+            }
+        }
+    }
+
+    /**
+     * @brief Writes the dirty registers of the peripheral in address order. Dirty registers of the same width at
+     * consecutive addresses are written in one burst, if the backend supports bursts.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static void sync()
+    {
+        constexpr const auto& map = register_cache_map<PeripheralBaseAddress>::registers;
+
+        auto&       cache = entries<PeripheralBaseAddress>;
+        std::size_t first = 0U;
+
+        while (first < map.size())
+        {
+            if (!cache[first].is_dirty)
+            {
+                first++;
+                continue;
+            }
+
+            std::size_t length = 1U;
+
+            while (first + length < map.size() and cache[first + length].is_dirty and
+                   map[first + length].size == map[first].size and
+                   map[first + length].offset == map[first + length - 1U].offset + (map[first].size / 8U))
+            {
+                length++;
+            }
+
+            switch (map[first].size)
+            {
+                case 8U:
+                    write_back<PeripheralBaseAddress, std::uint8_t>(first, length);
+                    break;
+                case 16U:
+                    write_back<PeripheralBaseAddress, std::uint16_t>(first, length);
+                    break;
+                default:
+                    write_back<PeripheralBaseAddress, std::uint32_t>(first, length);
+                    break;
+            }
+
+            first += length;
+        }
+    }
+
+    /**
+     * @brief Forgets the cached values, e.g. after the device was reset. Readable registers are read again on their
+     * next access, write-only registers are back at their reset value. Writes that were not synced are dropped.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static void invalidate() noexcept
+    {
+        entries<PeripheralBaseAddress> = get_initial_entries<PeripheralBaseAddress>();
+    }
+
+private:
+    /**
+     * @brief Cached value of a register.
+     */
+    struct entry
+    {
+        /* Cached value. */
+        utility::types::register_value_t value;
+        /* Whether the value is known. */
+        bool is_valid;
+        /* Whether the value still has to be written to the register. */
+        bool is_dirty;
+    };
+
+    /**
+     * @brief Returns the entries of an empty cache: write-only registers hold their reset value.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static consteval auto get_initial_entries()
+    {
+        constexpr const auto& map = register_cache_map<PeripheralBaseAddress>::registers;
+
+        static_assert(
+            []() {
+                for (std::size_t index = 0U; index < map.size(); index++)
+                {
+                    if (map[index].size > 32U or (index != 0U and map[index].offset <= map[index - 1U].offset))
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }(),
+            "Cached registers must be at most 32 bits, with unique offsets in ascending order.");
+
+        std::array<entry, map.size()> initial{};
+
+        for (std::size_t index = 0U; index < map.size(); index++)
+        {
+            initial[index] = entry{ .value    = map[index].value_on_reset,
+                                    .is_valid = !map[index].is_readable,
+                                    .is_dirty = false };
+        }
+
+        return initial;
+    }
+
+    /* Cached values of the registers of the peripheral at `PeripheralBaseAddress`. */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static inline constinit auto entries = get_initial_entries<PeripheralBaseAddress>();
+
+    /**
+     * @brief Writes `length` dirty registers of `Access` width, starting at index `first` of the cache map.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress, std::unsigned_integral Access>
+    static void write_back(const std::size_t first, const std::size_t length)
+    {
+        constexpr const auto& map = register_cache_map<PeripheralBaseAddress>::registers;
+
+        auto& cache = entries<PeripheralBaseAddress>;
+
+        std::array<Access, map.size()> values{};
+
+        for (std::size_t index = 0U; index < length; index++)
+        {
+            values[index]                = static_cast<Access>(cache[first + index].value);
+            cache[first + index].is_dirty = false;
+        }
+
+        if constexpr (requires(utility::types::register_address_t offset, std::span<const Access> burst) {
+                          Backend::template write_burst<PeripheralBaseAddress, Access>(offset, burst);
+                      })
+        {
+            Backend::template write_burst<PeripheralBaseAddress, Access>(
+                map[first].offset, std::span<const Access>{ values }.first(length));
+        }
+        else
+        {
+            for (std::size_t index = 0U; index < length; index++)
+            {
+                Backend::template write<PeripheralBaseAddress, write_type::normal, Access>(map[first + index].offset,
+                                                                                           values[index]);
+            }
+        }
+    }
+};
+
+}  // namespace tsri::backends
@@ -0,0 +1,541 @@
+/**
+ * @file cosim.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Backend for co-simulation with a device model in another process, over shared memory.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Driver code runs unmodified on the host while a device model runs in another process: a C++ or Python model, or an
+ * RTL model built with Verilator. Both processes open the same `cosim_channel`, a shared-memory segment with a
+ * register file and a doorbell:
+ * @code
+ * template<>
+ * struct tsri::backends::peripheral_backend<UART::base_address>
+ * {
+ *     using type = tsri::backends::cosim;
+ * };
+ *
+ * tsri::backends::cosim_channel channel{ "/uart_model", 0x1000U };
+ * tsri::backends::cosim::attach<UART::base_address>(channel);
+ * @endcode
+ *
+ * Most registers are plain storage: the driver reads and writes them in the shared register file, and the model reads
+ * and updates them there (e.g. sets status bits) whenever it likes. Accessing them costs no more than a memory access.
+ * Registers whose accesses have side effects, such as FIFO data registers and registers with write-clear or
+ * self-clearing fields, are listed in the `side_effect_map` of the peripheral. Their accesses are forwarded to the
+ * model through the doorbell, and the driver waits until the model has handled them:
+ * @code
+ * while (running)
+ * {
+ *     channel.serve([&](const tsri::backends::cosim_request& request) -> std::uint64_t { ... return read_value; });
+ * }
+ * @endcode
+ *
+ * The segment starts with a 64-byte `cosim_header`, followed by the register file. All fields are native-endian. A
+ * forwarded access is a request in the header: the driver takes `lock`, fills `request`, increments `request_sequence`
+ * and waits until `response_sequence` equals it. The model handles the request, stores the result of a read in
+ * `request.value` and then copies `request_sequence` to `response_sequence`. Both sides wake each other with futexes on
+ * the sequence words, but also poll them, so models that cannot use futexes (e.g. in Python) work too, with a higher
+ * latency.
+ *
+ * If the model process stops while a request is pending, the driver waits forever.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+#include "mapped.hpp"
+#include "write_type.hpp"
+
+namespace tsri::backends
+{
+
+/**
+ * @brief Kind of access that is forwarded to the model.
+ */
+enum class cosim_access : std::uint32_t
+{
+    /* Read of the register. */
+    read,
+    /* Write of the register. */
+    write,
+    /* Write of the atomic XOR alias: toggle the bits that are 1. */
+    write_xor,
+    /* Write of the atomic set alias: set the bits that are 1. */
+    write_set,
+    /* Write of the atomic clear alias: clear the bits that are 1. */
+    write_clear
+};
+
+/**
+ * @brief Access that is forwarded to the model.
+ */
+struct cosim_request
+{
+    /* Kind of access. */
+    cosim_access access;
+    /* Width of the access in bytes. */
+    std::uint32_t width;
+    /* Address of the register, as in the SVD file. */
+    std::uint64_t address;
+    /* Offset of the register in the register file. */
+    std::uint64_t offset;
+    /* Value to write, or the value that was read. */
+    std::uint64_t value;
+};
+
+static_assert(sizeof(cosim_request) == 32U, "The request layout is shared with models in other languages.");
+
+/**
+ * @brief Start of the shared-memory segment of a channel.
+ */
+struct cosim_header
+{
+    /* `cosim_channel::magic` once the segment is initialized. */
+    std::uint32_t magic;
+    /* `cosim_channel::version`. */
+    std::uint32_t version;
+    /* Size of the register file in bytes. */
+    std::uint32_t register_file_size;
+    /* 1 while a driver thread uses the request. */
+    std::uint32_t lock;
+    /* Incremented by the driver for every request. */
+    std::uint32_t request_sequence;
+    /* Set to `request_sequence` by the model when the request is handled. */
+    std::uint32_t response_sequence;
+    std::uint64_t reserved;
+    /* Pending request. */
+    cosim_request request;
+};
+
+static_assert(sizeof(cosim_header) == 64U, "The header layout is shared with models in other languages.");
+
+/**
+ * @brief Shared-memory segment between the driver and the model. Both processes open the channel; the first one
+ * initializes it. The segment stays until it is removed with `shm_unlink`.
+ *
+ * If opening fails, the channel is empty and `errno` tells why.
+ */
+class cosim_channel
+{
+public:
+    /* "TSRI" in a little-endian word. */
+    static constexpr std::uint32_t magic = 0x49525354U;
+
+    /* Version of the segment layout. */
+    static constexpr std::uint32_t version = 1U;
+
+    /**
+     * @brief Opens the channel in the open file `file_descriptor`, e.g. a `memfd` that is shared with a child process.
+     * The file is extended if it is too small.
+     *
+     * @param file_descriptor Open file, stays owned by the caller.
+     * @param register_file_size Size of the register file in bytes.
+     */
+    cosim_channel(const int file_descriptor, const std::size_t register_file_size) noexcept
+    {
+        const std::size_t size   = sizeof(cosim_header) + register_file_size;
+        struct stat       status = {};
+
+        if (::fstat(file_descriptor, &status) != 0 or
+            (static_cast<std::size_t>(status.st_size) < size and
+             ::ftruncate(file_descriptor, static_cast<off_t>(size)) != 0))
+        {
+            return;
+        }
+
+        region = mapped_region{ file_descriptor, 0, size };
+
+        if (region)
+        {
+            auto&                                segment_header = header();
+            const std::atomic_ref<std::uint32_t> segment_magic{ segment_header.magic };
+
+            if (segment_magic.load(std::memory_order_acquire) == 0U)
+            {
+                segment_header.version            = version;
+                segment_header.register_file_size = static_cast<std::uint32_t>(register_file_size);
+                segment_magic.store(magic, std::memory_order_release);
+            }
+
+            if (segment_header.version != version or segment_header.register_file_size < register_file_size)
+            {
+                region = mapped_region{};
+            }
+        }
+    }
+
+    /**
+     * @brief Opens or creates the POSIX shared-memory object `name` and opens the channel in it.
+     *
+     * @param name Name of the shared-memory object, e.g. `/uart_model`.
+     * @param register_file_size Size of the register file in bytes.
+     */
+    cosim_channel(const char* const name, const std::size_t register_file_size) noexcept
+    {
+        const int file_descriptor = ::shm_open(name, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+
+        if (file_descriptor >= 0)
+        {
+            *this = cosim_channel{ file_descriptor, register_file_size };
+
+            ::close(file_descriptor);
+        }
+    }
+
+    cosim_channel(const cosim_channel&)                        = delete;
+    auto operator=(const cosim_channel&) -> cosim_channel&     = delete;
+    cosim_channel(cosim_channel&&) noexcept                    = default;
+    auto operator=(cosim_channel&&) noexcept -> cosim_channel& = default;
+    ~cosim_channel()                                           = default;
+
+    /**
+     * @brief Returns `true` if the channel is open.
+     */
+    [[nodiscard]] explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(region);
+    }
+
+    /**
+     * @brief Returns an atomic reference to the register at `offset` in the register file. The model uses this to
+     * update registers, e.g. with `fetch_or` to set a status bit without losing concurrent writes of the driver.
+     *
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset of the register in the register file.
+     */
+    template<std::unsigned_integral Access>
+    [[nodiscard]] TSRI_INLINE auto register_at(const std::size_t offset) const noexcept -> std::atomic_ref<Access>
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): the register file holds the register values.
+        return std::atomic_ref<Access>{ *reinterpret_cast<Access*>(region.data() + sizeof(cosim_header) + offset) };
+    }
+
+    /**
+     * @brief Forwards an access to the model, and waits until the model has handled it. Called by the driver.
+     *
+     * @param access Access to forward.
+     * @return std::uint64_t Value that the model returned, i.e. the value that was read.
+     */
+    auto request(const cosim_request& access) noexcept -> std::uint64_t
+    {
+        auto&                                segment_header = header();
+        const std::atomic_ref<std::uint32_t> lock{ segment_header.lock };
+        const std::atomic_ref<std::uint32_t> request_sequence{ segment_header.request_sequence };
+        const std::atomic_ref<std::uint32_t> response_sequence{ segment_header.response_sequence };
+
+        while (lock.exchange(1U, std::memory_order_acquire) != 0U)
+        {
+            std::this_thread::yield();
+        }
+
+        segment_header.request = access;
+
+        const std::uint32_t sequence = request_sequence.load(std::memory_order_relaxed) + 1U;
+
+        request_sequence.store(sequence, std::memory_order_release);
+        wake(segment_header.request_sequence);
+
+        /* The model usually answers within microseconds, spin for a while before sleeping. */
+        std::uint32_t spins    = 0U;
+        std::uint32_t response = response_sequence.load(std::memory_order_acquire);
+
+        while (response != sequence)
+        {
+            if (spins < spin_limit)
+            {
+                spins++;
+            }
+            else
+            {
+                wait(segment_header.response_sequence, response, poll_interval_ms);
+            }
+
+            response = response_sequence.load(std::memory_order_acquire);
+        }
+
+        const std::uint64_t value = segment_header.request.value;
+
+        lock.store(0U, std::memory_order_release);
+
+        return value;
+    }
+
+    /**
+     * @brief Handles the pending request, waiting up to `timeout_ms` for one. Called by the model.
+     *
+     * The handler performs the access on the model, e.g. pops a FIFO or clears write-clear bits in the register file,
+     * and returns the value that is read. The return value of writes is ignored.
+     *
+     * @param handler Function that takes the request (`const cosim_request&`) and returns `std::uint64_t`.
+     * @param timeout_ms Time to wait in milliseconds, -1 to wait forever and 0 to not wait.
+     * @return true A request was handled.
+     * @return false No request arrived in time. Waits can end early, so a return of `false` does not mean that the
+     * timeout passed.
+     */
+    template<typename Handler>
+        requires std::is_invocable_r_v<std::uint64_t, Handler&, const cosim_request&>
+    auto serve(Handler&& handler, const int timeout_ms = -1) -> bool
+    {
+        auto&                                segment_header = header();
+        const std::atomic_ref<std::uint32_t> request_sequence{ segment_header.request_sequence };
+        const std::atomic_ref<std::uint32_t> response_sequence{ segment_header.response_sequence };
+
+        const std::uint32_t handled  = response_sequence.load(std::memory_order_relaxed);
+        std::uint32_t       sequence = request_sequence.load(std::memory_order_acquire);
+
+        if (sequence == handled and timeout_ms != 0)
+        {
+            wait(segment_header.request_sequence, handled, timeout_ms);
+
+            sequence = request_sequence.load(std::memory_order_acquire);
+        }
+
+        if (sequence == handled)
+        {
+            return false;
+        }
+
+        segment_header.request.value = handler(std::as_const(segment_header.request));
+
+        response_sequence.store(sequence, std::memory_order_release);
+        wake(segment_header.response_sequence);
+
+        return true;
+    }
+
+private:
+    /* Number of polls of the response before the driver sleeps. */
+    static constexpr std::uint32_t spin_limit = 1024U;
+
+    /* Time the driver sleeps between polls, for models that do not wake it. */
+    static constexpr int poll_interval_ms = 1;
+
+    mapped_region region;
+
+    [[nodiscard]] auto header() const noexcept -> cosim_header&
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): the segment starts with the header.
+        return *reinterpret_cast<cosim_header*>(region.data());
+    }
+
+    /**
+     * @brief Sleeps while `word` is `value`, at most `timeout_ms` (-1: no limit). The futex is not private, so it works
+     * across processes.
+     */
+    static void wait(std::uint32_t& word, const std::uint32_t value, const int timeout_ms) noexcept
+    {
+        const timespec timeout{ .tv_sec = timeout_ms / 1000, .tv_nsec = (timeout_ms % 1000) * 1000000L };
+
+        ::syscall(SYS_futex, &word, FUTEX_WAIT, value, timeout_ms < 0 ? nullptr : &timeout, nullptr, 0);
+    }
+
+    /**
+     * @brief Wakes all processes that sleep on `word`.
+     */
+    static void wake(std::uint32_t& word) noexcept
+    {
+        ::syscall(SYS_futex, &word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+};
+
+/**
+ * @brief Registers of the peripheral at `PeripheralBaseAddress` whose accesses have side effects, and are forwarded to
+ * the model by the `cosim` backend. By default there are none. Specialize this, or generate it with `--cosim`.
+ *
+ * @tparam PeripheralBaseAddress Base address of the peripheral.
+ */
+template<utility::types::register_address_t PeripheralBaseAddress>
+struct side_effect_map
+{
+    /* Offsets of the registers from the peripheral base address. */
+    static constexpr std::array<utility::types::register_address_t, 0U> offsets{};
+};
+
+/**
+ * @brief Accesses registers in the register file of a co-simulation channel, and forwards accesses to registers with
+ * side effects to the model.
+ */
+class cosim
+{
+public:
+    cosim()                                = delete;
+    cosim(cosim&&)                         = delete;
+    cosim(const cosim&)                    = delete;
+    auto operator=(cosim&&) -> cosim&      = delete;
+    auto operator=(const cosim&) -> cosim& = delete;
+    ~cosim()                               = delete;
+
+    /**
+     * @brief Makes the registers of the peripheral at `PeripheralBaseAddress` access the register file of `channel`,
+     * starting at `file_offset`.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral, as in the SVD file.
+     * @param channel Channel, which must outlive the accesses and stay at the same address.
+     * @param file_offset Offset of the peripheral in the register file.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static void attach(cosim_channel& channel, const std::size_t file_offset = 0U) noexcept
+    {
+        attached_window<PeripheralBaseAddress> = window{ .channel = &channel, .file_offset = file_offset };
+    }
+
+    /**
+     * @brief Reads the register at `offset` from the peripheral base address.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @return Access Register value.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    [[nodiscard]] TSRI_INLINE static auto read(const utility::types::register_address_t offset) noexcept -> Access
+    {
+        const window& peripheral = attached_window<PeripheralBaseAddress>;
+
+        if (has_side_effects<PeripheralBaseAddress>(offset))
+        {
+            return static_cast<Access>(peripheral.channel->request(
+                get_request<PeripheralBaseAddress, Access>(cosim_access::read, offset, 0U)));
+        }
+
+        return peripheral.channel->template register_at<Access>(peripheral.file_offset + offset)
+            .load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Writes the register at `offset` from the peripheral base address, or one of its atomic aliases.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam WriteType Type of the write.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param value Value to write.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        write_type                         WriteType = write_type::normal,
+        std::unsigned_integral             Access    = utility::types::register_value_t>
+    TSRI_INLINE static void write(const utility::types::register_address_t offset, const Access value) noexcept
+    {
+        const window& peripheral = attached_window<PeripheralBaseAddress>;
+
+        if (has_side_effects<PeripheralBaseAddress>(offset))
+        {
+            static_cast<void>(peripheral.channel->request(
+                get_request<PeripheralBaseAddress, Access>(get_access<WriteType>(), offset, value)));
+
+            return;
+        }
+
+        const auto register_ref = peripheral.channel->template register_at<Access>(peripheral.file_offset + offset);
+
+        if constexpr (WriteType == write_type::atomic_xor)
+        {
+            register_ref.fetch_xor(value, std::memory_order_acq_rel);
+        }
+        else if constexpr (WriteType == write_type::atomic_set)
+        {
+            register_ref.fetch_or(value, std::memory_order_acq_rel);
+        }
+        else if constexpr (WriteType == write_type::atomic_clear)
+        {
+            register_ref.fetch_and(static_cast<Access>(~value), std::memory_order_acq_rel);
+        }
+        else
+        {
+            register_ref.store(value, std::memory_order_release);
+        }
+    }
+
+private:
+    /**
+     * @brief Part of the register file that holds the registers of a peripheral.
+     */
+    struct window
+    {
+        cosim_channel* channel;
+        std::size_t    file_offset;
+    };
+
+    /* Window of the peripheral at `PeripheralBaseAddress`, without a channel while it is not attached. */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static inline constinit window attached_window{ .channel = nullptr, .file_offset = 0U };
+
+    /**
+     * @brief Returns `true` if the register at `offset` is in the side-effect map of the peripheral.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    [[nodiscard]] TSRI_INLINE static constexpr auto has_side_effects(
+        const utility::types::register_address_t offset) noexcept -> bool
+    {
+        constexpr const auto& offsets = side_effect_map<PeripheralBaseAddress>::offsets;
+
+        for (const auto side_effect_offset : offsets)
+        {
+            if (side_effect_offset == offset)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Returns the kind of access of a write with `WriteType`.
+     */
+    template<write_type WriteType>
+    [[nodiscard]] static consteval auto get_access() noexcept -> cosim_access
+    {
+        switch (WriteType)
+        {
+            case write_type::atomic_xor:
+                return cosim_access::write_xor;
+            case write_type::atomic_set:
+                return cosim_access::write_set;
+            case write_type::atomic_clear:
+                return cosim_access::write_clear;
+            default:
+                return cosim_access::write;
+        }
+    }
+
+    /**
+     * @brief Returns the request for an access to the register at `offset`.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress, std::unsigned_integral Access>
+    [[nodiscard]] TSRI_INLINE static auto get_request(const cosim_access                       access,
+                                                      const utility::types::register_address_t offset,
+                                                      const Access                             value) noexcept
+        -> cosim_request
+    {
+        return cosim_request{ .access  = access,
+                              .width   = sizeof(Access),
+                              .address = static_cast<std::uint64_t>(PeripheralBaseAddress) + offset,
+                              .offset  = attached_window<PeripheralBaseAddress>.file_offset + offset,
+                              .value   = value };
+    }
+};
+
+}  // namespace tsri::backends
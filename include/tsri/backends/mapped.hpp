@@ -0,0 +1,426 @@
+/**
+ * @file mapped.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Backend for registers that are mapped into a Linux userspace process.
+ * @version 0.1
+ * @date 2025-08-09
+ *
+ * On Linux, peripherals are driven from userspace by mapping their registers with `mmap`, either through a UIO device
+ * (`/dev/uioN`) or through `/dev/mem`. The virtual address of a peripheral is then only known at runtime, while the
+ * offsets, masks and field checks of its registers stay compile-time constants. The mapped backend keeps one base
+ * pointer per peripheral, which is attached after mapping:
+ * @code
+ * template<>
+ * struct tsri::backends::peripheral_backend<0x40010000U>
+ * {
+ *     using type = tsri::backends::mapped;
+ * };
+ *
+ * const tsri::backends::mapped_region region{ "/dev/uio0", 0U, 0x1000U };
+ * tsri::backends::mapped::attach<0x40010000U>(region);
+ *
+ * GPIO::DATA::set_fields(GPIO::DATA::PIN3::value{ 1U });
+ * @endcode
+ *
+ * Reads and writes are single volatile loads and stores with the width of the register, like the memory-mapped
+ * backend. No exclusive (LDREX/STREX, LR/SC) accesses are used: they are not allowed on device memory on Arm.
+ *
+ * Peripherals with atomic aliases (e.g. on the RP2040) get them by mapping the whole alias range, the register block and
+ * the XOR, set and clear pages behind it (4 pages of 0x1000 bytes), and attaching it with `alias_pages::mapped`. Writes
+ * to the atomic aliases are then single stores, as on the bare-metal target. Without the alias pages, and for the other
+ * read-modify-writes of the registers (see `modify` and `toggle`), the register is read and written with a plain load
+ * and store while holding the lock of the peripheral. The lock serializes the threads of this process that use the
+ * backend, it does not protect against other processes or kernel drivers that access the same registers. The registers
+ * pass the bits of their write-clear fields to `modify` and `toggle`, which are written as 0, so a read-modify-write
+ * does not acknowledge pending interrupts.
+ *
+ * A `memfd` or a plain file can be mapped in place of the device, so code that uses this backend can be tested on any
+ * Linux machine.
+ *
+ * Accessing a peripheral that has not been attached dereferences a null pointer.
+ */
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+#include "write_type.hpp"
+
+namespace tsri::backends
+{
+
+/**
+ * @brief Memory mapping of (part of) a file, e.g. a UIO device, `/dev/mem` or a `memfd`. The mapping is removed when
+ * the region is destroyed.
+ *
+ * If mapping fails, the region is empty and `errno` tells why.
+ */
+class mapped_region
+{
+public:
+    /**
+     * @brief Creates an empty region.
+     */
+    mapped_region() noexcept = default;
+
+    /**
+     * @brief Maps `length` bytes of the open file `file_descriptor`, starting at byte `offset`.
+     * The offset does not have to be page-aligned, e.g. the physical address of a peripheral in `/dev/mem`.
+     *
+     * @note The memory maps of a UIO device are selected by offset: map N is at N times the page size.
+     *
+     * @param file_descriptor Open file, stays owned by the caller.
+     * @param offset Offset of the region in the file.
+     * @param length Length of the region in bytes.
+     */
+    mapped_region(const int file_descriptor, const off_t offset, const std::size_t length) noexcept
+    {
+        const auto page_offset = static_cast<std::size_t>(offset % ::sysconf(_SC_PAGESIZE));
+
+        void* const mapping = ::mmap(nullptr,
+                                     length + page_offset,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_SHARED,
+                                     file_descriptor,
+                                     offset - static_cast<off_t>(page_offset));
+
+        if (mapping != MAP_FAILED)
+        {
+            mapping_base   = static_cast<std::byte*>(mapping);
+            mapping_length = length + page_offset;
+            region         = mapping_base + page_offset;
+        }
+    }
+
+    /**
+     * @brief Opens the file at `path` and maps `length` bytes of it, starting at byte `offset`. The file is closed
+     * again after mapping, the mapping stays valid.
+     *
+     * @param path Path of the file, e.g. `/dev/uio0` or `/dev/mem`.
+     * @param offset Offset of the region in the file.
+     * @param length Length of the region in bytes.
+     */
+    mapped_region(const char* const path, const off_t offset, const std::size_t length) noexcept
+    {
+        const int file_descriptor = ::open(path, O_RDWR | O_SYNC | O_CLOEXEC);
+
+        if (file_descriptor >= 0)
+        {
+            *this = mapped_region{ file_descriptor, offset, length };
+
+            ::close(file_descriptor);
+        }
+    }
+
+    mapped_region(const mapped_region&)                    = delete;
+    auto operator=(const mapped_region&) -> mapped_region& = delete;
+
+    mapped_region(mapped_region&& other) noexcept
+        : mapping_base{ std::exchange(other.mapping_base, nullptr) },
+          mapping_length{ std::exchange(other.mapping_length, 0U) },
+          region{ std::exchange(other.region, nullptr) }
+    {}
+
+    auto operator=(mapped_region&& other) noexcept -> mapped_region&
+    {
+        std::swap(mapping_base, other.mapping_base);
+        std::swap(mapping_length, other.mapping_length);
+        std::swap(region, other.region);
+
+        return *this;
+    }
+
+    ~mapped_region()
+    {
+        if (mapping_base != nullptr)
+        {
+            ::munmap(mapping_base, mapping_length);
+        }
+    }
+
+    /**
+     * @brief Returns the first byte of the region, or `nullptr` if mapping failed.
+     */
+    [[nodiscard]] auto data() const noexcept -> std::byte*
+    {
+        return region;
+    }
+
+    /**
+     * @brief Returns the length of the region in bytes, or 0 if mapping failed.
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return region == nullptr ? 0U : mapping_length - static_cast<std::size_t>(region - mapping_base);
+    }
+
+    /**
+     * @brief Returns `true` if the region is mapped.
+     */
+    [[nodiscard]] explicit operator bool() const noexcept
+    {
+        return region != nullptr;
+    }
+
+private:
+    /* Page-aligned start and length of the mapping. */
+    std::byte*  mapping_base   = nullptr;
+    std::size_t mapping_length = 0U;
+
+    /* Start of the requested region inside the mapping. */
+    std::byte* region = nullptr;
+};
+
+/**
+ * @brief Whether the atomic alias pages of a peripheral are mapped behind its registers.
+ */
+enum class alias_pages : bool
+{
+    /* Only the registers are mapped. Writes to the atomic aliases are read-modify-writes under a lock. */
+    absent,
+    /* The XOR, set and clear pages are mapped at 0x1000, 0x2000 and 0x3000 bytes from the registers. */
+    mapped
+};
+
+/**
+ * @brief Accesses registers through the runtime base pointers of mapped peripherals.
+ */
+class mapped
+{
+public:
+    mapped()                                 = delete;
+    mapped(mapped&&)                         = delete;
+    mapped(const mapped&)                    = delete;
+    auto operator=(mapped&&) -> mapped&      = delete;
+    auto operator=(const mapped&) -> mapped& = delete;
+    ~mapped()                                = delete;
+
+    /**
+     * @brief Makes the registers of the peripheral at `PeripheralBaseAddress` access the memory at `base`.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral, as in the SVD file.
+     * @param base Virtual address of the peripheral, or `nullptr` to detach it.
+     * @param aliases Whether the atomic alias pages are mapped behind the registers.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static void attach(std::byte* const base, const alias_pages aliases = alias_pages::absent) noexcept
+    {
+        peripheral_aliases<PeripheralBaseAddress>.store(aliases, std::memory_order_relaxed);
+        peripheral_base<PeripheralBaseAddress>.store(base, std::memory_order_release);
+    }
+
+    /**
+     * @brief Makes the registers of the peripheral at `PeripheralBaseAddress` access the start of `region`.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral, as in the SVD file.
+     * @param region Mapped region, which must outlive the accesses.
+     * @param aliases Whether the region includes the atomic alias pages, see `alias_pages`.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static void attach(const mapped_region& region, const alias_pages aliases = alias_pages::absent) noexcept
+    {
+        attach<PeripheralBaseAddress>(region.data(), aliases);
+    }
+
+    /**
+     * @brief Returns `true` if the atomic alias pages of the peripheral at `PeripheralBaseAddress` are mapped. If not,
+     * the registers perform their atomic writes with `modify` and `toggle`.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    [[nodiscard]] TSRI_INLINE static auto has_atomic_aliases() noexcept -> bool
+    {
+        return peripheral_aliases<PeripheralBaseAddress>.load(std::memory_order_relaxed) == alias_pages::mapped;
+    }
+
+    /**
+     * @brief Reads the register at `offset` from the peripheral base address.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @return Access Register value.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    [[nodiscard]] TSRI_INLINE static auto read(const utility::types::register_address_t offset) noexcept -> Access
+    {
+        return *get_register<PeripheralBaseAddress, Access>(offset);
+    }
+
+    /**
+     * @brief Writes the register at `offset` from the peripheral base address, or one of its atomic aliases. Without
+     * the alias pages, atomic writes are read-modify-writes of the register itself under the lock of the peripheral.
+     *
+     * @note This function does not know the write-clear fields of the register, so an emulated atomic write writes back
+     * the write-clear bits that are set. The registers use `modify` and `toggle` instead, which do not.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam WriteType Type of the write.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param value Value to write.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        write_type                         WriteType = write_type::normal,
+        std::unsigned_integral             Access    = utility::types::register_value_t>
+    TSRI_INLINE static void write(const utility::types::register_address_t offset, const Access value) noexcept
+    {
+        if constexpr (WriteType == write_type::normal)
+        {
+            *get_register<PeripheralBaseAddress, Access>(offset) = value;
+        }
+        else if (has_atomic_aliases<PeripheralBaseAddress>())
+        {
+            *get_register<PeripheralBaseAddress, Access>(offset + alias_offset<WriteType>) = value;
+        }
+        else if constexpr (WriteType == write_type::atomic_xor)
+        {
+            toggle<PeripheralBaseAddress, Access>(offset, value, Access{ 0U });
+        }
+        else if constexpr (WriteType == write_type::atomic_set)
+        {
+            modify<PeripheralBaseAddress, Access>(offset, Access{ 0U }, value);
+        }
+        else
+        {
+            modify<PeripheralBaseAddress, Access>(offset, value, Access{ 0U });
+        }
+    }
+
+    /**
+     * @brief Clears the bits of `clear_mask` and sets the bits of `set_value` in the register at `offset`, with a load
+     * and a store under the lock of the peripheral. Modifications of other bits by other threads of the process are not
+     * lost.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param clear_mask Bits to clear, including the write-clear bits that must not be written back.
+     * @param set_value Bits to set.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    TSRI_INLINE static void modify(const utility::types::register_address_t offset,
+                                   const Access                             clear_mask,
+                                   const Access                             set_value) noexcept
+    {
+        volatile Access* const register_pointer = get_register<PeripheralBaseAddress, Access>(offset);
+
+        const std::scoped_lock lock{ peripheral_lock<PeripheralBaseAddress> };
+
+        *register_pointer = static_cast<Access>((*register_pointer & ~clear_mask) | set_value);
+    }
+
+    /**
+     * @brief Toggles the bits of `toggle_mask` in the register at `offset`, with a load and a store under the lock of
+     * the peripheral.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param toggle_mask Bits to toggle.
+     * @param clear_mask Bits to write as 0, i.e. the write-clear bits that must not be written back.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    TSRI_INLINE static void toggle(const utility::types::register_address_t offset,
+                                   const Access                             toggle_mask,
+                                   const Access                             clear_mask) noexcept
+    {
+        volatile Access* const register_pointer = get_register<PeripheralBaseAddress, Access>(offset);
+
+        const std::scoped_lock lock{ peripheral_lock<PeripheralBaseAddress> };
+
+        *register_pointer = static_cast<Access>((*register_pointer ^ toggle_mask) & ~clear_mask);
+    }
+
+    /**
+     * @brief Reads the register at `offset` and writes back the bits of `keep_mask` of the value that was read, with a
+     * load and a store under the lock of the peripheral. Used to acknowledge the write-clear bits that were read.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param keep_mask Bits of the value that was read to write back.
+     * @return Access Value that was read.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    TSRI_INLINE static auto read_and_write_back(const utility::types::register_address_t offset,
+                                                const Access                             keep_mask) noexcept -> Access
+    {
+        volatile Access* const register_pointer = get_register<PeripheralBaseAddress, Access>(offset);
+
+        const std::scoped_lock lock{ peripheral_lock<PeripheralBaseAddress> };
+
+        const Access value = *register_pointer;
+
+        *register_pointer = static_cast<Access>(value & keep_mask);
+
+        return value;
+    }
+
+    /**
+     * @brief Returns a pointer to the first byte of the attached peripheral.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @return volatile unsigned char* Pointer to the peripheral.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    [[nodiscard]] TSRI_INLINE static auto base_pointer() noexcept -> volatile unsigned char*
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): the mapping is accessed as raw bytes.
+        return reinterpret_cast<volatile unsigned char*>(
+            peripheral_base<PeripheralBaseAddress>.load(std::memory_order_acquire));
+    }
+
+private:
+    /**
+     * @brief Virtual address of the peripheral at `PeripheralBaseAddress`, `nullptr` while it is not attached.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static inline constinit std::atomic<std::byte*> peripheral_base{ nullptr };
+
+    /**
+     * @brief Whether the atomic alias pages of the peripheral at `PeripheralBaseAddress` are mapped.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static inline constinit std::atomic<alias_pages> peripheral_aliases{ alias_pages::absent };
+
+    /**
+     * @brief Lock of the read-modify-writes of the registers of the peripheral at `PeripheralBaseAddress`.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static inline constinit std::mutex peripheral_lock{};
+
+    /**
+     * @brief Returns a pointer to the register at `offset` from the attached peripheral.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress, std::unsigned_integral Access>
+    [[nodiscard]] TSRI_INLINE static auto get_register(const utility::types::register_address_t offset) noexcept
+        -> volatile Access*
+    {
+        std::byte* const base = peripheral_base<PeripheralBaseAddress>.load(std::memory_order_acquire);
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): the mapping holds the register values.
+        return reinterpret_cast<volatile Access*>(base + offset);
+    }
+};
+
+}  // namespace tsri::backends
@@ -0,0 +1,80 @@
+/**
+ * @file mmio.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Backend for memory-mapped registers.
+ * @version 0.1
+ * @date 2025-08-05
+ */
+#pragma once
+
+#include <bit>
+#include <concepts>
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+#include "write_type.hpp"
+
+namespace tsri::backends
+{
+
+/**
+ * @brief Accesses registers through volatile pointers to their addresses. This is the default backend.
+ */
+struct mmio
+{
+    /**
+     * @brief Reads the register at `offset` from the peripheral base address.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @return Access Register value.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    [[nodiscard]] TSRI_INLINE static auto read(const utility::types::register_address_t offset) noexcept -> Access
+    {
+        return *std::bit_cast<volatile Access*>(PeripheralBaseAddress + offset);
+    }
+
+    /**
+     * @brief Writes the register at `offset` from the peripheral base address, or one of its atomic aliases.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam WriteType Type of the write.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param value Value to write.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        write_type                         WriteType = write_type::normal,
+        std::unsigned_integral             Access    = utility::types::register_value_t>
+    TSRI_INLINE static void write(const utility::types::register_address_t offset, const Access value) noexcept
+    {
+        *std::bit_cast<volatile Access*>(PeripheralBaseAddress + offset + alias_offset<WriteType>) = value;
+    }
+
+    /**
+     * @brief Returns a pointer to the first byte of the peripheral.
+     * The base address is hidden from the optimizer. Otherwise it would fold offsets from the pointer back into
+     * absolute addresses, each of which needs its own literal pool entry.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @return volatile unsigned char* Pointer to the peripheral.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    [[nodiscard]] TSRI_INLINE static auto base_pointer() noexcept -> volatile unsigned char*
+    {
+        auto* base = std::bit_cast<volatile unsigned char*>(PeripheralBaseAddress);
+
+#ifdef __GNUC__
+        asm("" : "+r"(base));
+#endif
+
+        return base;
+    }
+};
+
+}  // namespace tsri::backends
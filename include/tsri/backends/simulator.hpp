@@ -0,0 +1,330 @@
+/**
+ * @file simulator.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Backend that simulates registers on the host.
+ * @version 0.1
+ * @date 2025-08-05
+ *
+ * The simulator keeps the register values in a register file in RAM, so code that uses TSRI can run and be tested on
+ * the host. Registers that have never been written read as 0; tests can give them a value using `simulator::set()`.
+ * Writes to the atomic aliases are applied to the register, like the hardware would.
+ *
+ * Values are stored with 64 bits, so registers of any width can be simulated. Narrower reads truncate the stored value.
+ *
+ * Device models make registers change on their own, so polling loops and interrupt dispatchers can be tested. Time is
+ * virtual and deterministic: every register access takes one cycle. Models react to accesses with `on_read` and
+ * `on_write` hooks, and to time with events that are `schedule`d a number of cycles ahead. Events that are due run
+ * before the access that makes them due, in the order in which they were scheduled. E.g. a PLL that locks 100 cycles
+ * after it is enabled:
+ * @code
+ * simulator::on_write(PLL::CS::address, [](const std::uint64_t value) {
+ *     if ((value & ENABLE) != 0U)
+ *     {
+ *         simulator::schedule(100U, [] { simulator::set(PLL::CS::address, simulator::get(PLL::CS::address) | LOCK); });
+ *     }
+ * });
+ * @endcode
+ * Models change registers with `get()` and `set()`, which are not register accesses and take no time. The access
+ * counters then tell how many reads a wait loop or dispatcher needed before it made progress.
+ *
+ * The simulator is meant for host builds and uses the standard library containers. It is not thread-safe.
+ */
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+#include "write_type.hpp"
+
+namespace tsri::backends
+{
+
+/**
+ * @brief Accesses registers in a simulated register file.
+ */
+class simulator
+{
+public:
+    /* Virtual time, in register accesses. */
+    using cycles_t = std::uint64_t;
+
+    /* Reaction of a device model to a read of a register, or to time passing. */
+    using callback_t = std::function<void()>;
+
+    /* Reaction of a device model to a write of a register, gets the new register value. */
+    using write_callback_t = std::function<void(std::uint64_t value)>;
+
+    /**
+     * @brief Reads the register at `offset` from the peripheral base address. Takes one cycle; the `on_read` hooks of
+     * the register run before the value is read, so they can e.g. pop a FIFO into the register.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @return Access Register value.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    [[nodiscard]] static auto read(const utility::types::register_address_t offset) -> Access
+    {
+        const utility::types::register_address_t address = PeripheralBaseAddress + offset;
+
+        advance(1U);
+        simulation().reads[address]++;
+        simulation().total_reads++;
+
+        if (const auto hooks = simulation().read_hooks.find(address); hooks != simulation().read_hooks.end())
+        {
+            for (const auto& hook : hooks->second)
+            {
+                hook();
+            }
+        }
+
+        return static_cast<Access>(get(address));
+    }
+
+    /**
+     * @brief Writes the register at `offset` from the peripheral base address, or one of its atomic aliases. Takes one
+     * cycle; the `on_write` hooks of the register run after the value is written.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam WriteType Type of the write.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param value Value to write.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        write_type                         WriteType = write_type::normal,
+        std::unsigned_integral             Access    = utility::types::register_value_t>
+    static void write(const utility::types::register_address_t offset, const Access value)
+    {
+        const utility::types::register_address_t address = PeripheralBaseAddress + offset;
+
+        advance(1U);
+        simulation().writes[address]++;
+        simulation().total_writes++;
+
+        auto& register_value = simulation().registers[address];
+
+        switch (WriteType)
+        {
+            case write_type::atomic_xor:
+                register_value ^= value;
+                break;
+            case write_type::atomic_set:
+                register_value |= value;
+                break;
+            case write_type::atomic_clear:
+                register_value &= ~value;
+                break;
+            default:
+                register_value = value;
+                break;
+        }
+
+        if (const auto hooks = simulation().write_hooks.find(address); hooks != simulation().write_hooks.end())
+        {
+            const std::uint64_t new_value = register_value;
+
+            for (const auto& hook : hooks->second)
+            {
+                hook(new_value);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the value of the register at `address`, without counting as a register access.
+     *
+     * @param address Register address.
+     * @return std::uint64_t Register value.
+     */
+    [[nodiscard]] static auto get(const utility::types::register_address_t address) -> std::uint64_t
+    {
+        const auto found = simulation().registers.find(address);
+
+        return found == simulation().registers.end() ? 0U : found->second;
+    }
+
+    /**
+     * @brief Sets the value of the register at `address`, e.g. to simulate hardware changing a status register.
+     *
+     * @param address Register address.
+     * @param value Register value.
+     */
+    static void set(const utility::types::register_address_t address, const std::uint64_t value)
+    {
+        simulation().registers[address] = value;
+    }
+
+    /**
+     * @brief Calls `hook` on every read of the register at `address`, before the value is read.
+     *
+     * @param address Register address.
+     * @param hook Reaction of the device model.
+     */
+    static void on_read(const utility::types::register_address_t address, callback_t hook)
+    {
+        simulation().read_hooks[address].push_back(std::move(hook));
+    }
+
+    /**
+     * @brief Calls `hook` with the new register value on every write of the register at `address`, or of one of its
+     * atomic aliases.
+     *
+     * @param address Register address.
+     * @param hook Reaction of the device model.
+     */
+    static void on_write(const utility::types::register_address_t address, write_callback_t hook)
+    {
+        simulation().write_hooks[address].push_back(std::move(hook));
+    }
+
+    /**
+     * @brief Calls `event` when `delay` more cycles have passed, before the register access at that time. Events can
+     * schedule themselves again, e.g. to simulate a UART that receives a byte every N cycles.
+     *
+     * @param delay Number of cycles from now, 0 to run at the next access.
+     * @param event Reaction of the device model.
+     */
+    static void schedule(const cycles_t delay, callback_t event)
+    {
+        simulation().events.emplace(simulation().now + delay, std::move(event));
+    }
+
+    /**
+     * @brief Returns the virtual time: the number of cycles since the last `clear()`.
+     */
+    [[nodiscard]] static auto now() -> cycles_t
+    {
+        return simulation().now;
+    }
+
+    /**
+     * @brief Lets `cycles` cycles pass without register accesses, e.g. to simulate a delay, and runs the events that
+     * become due. Each event runs at its own time, so events that schedule themselves again keep their period.
+     *
+     * @param cycles Number of cycles.
+     */
+    static void advance(const cycles_t cycles)
+    {
+        auto&          state = simulation();
+        const cycles_t end   = state.now + cycles;
+
+        /* Events can schedule new events, which may be due already. */
+        while (!state.events.empty() and state.events.begin()->first <= end)
+        {
+            const auto event = state.events.extract(state.events.begin());
+
+            state.now = event.key();
+            event.mapped()();
+        }
+
+        state.now = end;
+    }
+
+    /**
+     * @brief Returns the number of register reads since the last `clear()` or `reset_counts()`.
+     */
+    [[nodiscard]] static auto reads() -> std::uint64_t
+    {
+        return simulation().total_reads;
+    }
+
+    /**
+     * @brief Returns the number of reads of the register at `address` since the last `clear()` or `reset_counts()`.
+     *
+     * @param address Register address.
+     */
+    [[nodiscard]] static auto reads(const utility::types::register_address_t address) -> std::uint64_t
+    {
+        const auto found = simulation().reads.find(address);
+
+        return found == simulation().reads.end() ? 0U : found->second;
+    }
+
+    /**
+     * @brief Returns the number of register writes since the last `clear()` or `reset_counts()`.
+     */
+    [[nodiscard]] static auto writes() -> std::uint64_t
+    {
+        return simulation().total_writes;
+    }
+
+    /**
+     * @brief Returns the number of writes of the register at `address` since the last `clear()` or `reset_counts()`.
+     *
+     * @param address Register address.
+     */
+    [[nodiscard]] static auto writes(const utility::types::register_address_t address) -> std::uint64_t
+    {
+        const auto found = simulation().writes.find(address);
+
+        return found == simulation().writes.end() ? 0U : found->second;
+    }
+
+    /**
+     * @brief Sets the access counters to 0, e.g. before the code that is measured. The time keeps running.
+     */
+    static void reset_counts()
+    {
+        auto& state = simulation();
+
+        state.reads.clear();
+        state.writes.clear();
+        state.total_reads  = 0U;
+        state.total_writes = 0U;
+    }
+
+    /**
+     * @brief Forgets all register values, device models, events and counters, such that all registers read as 0 again
+     * and the time starts at 0.
+     */
+    static void clear()
+    {
+        simulation() = state_t{};
+    }
+
+private:
+    /**
+     * @brief Simulated register file and device models.
+     */
+    struct state_t
+    {
+        /* Maps register addresses to their values. */
+        std::unordered_map<utility::types::register_address_t, std::uint64_t> registers;
+
+        std::unordered_map<utility::types::register_address_t, std::vector<callback_t>>       read_hooks;
+        std::unordered_map<utility::types::register_address_t, std::vector<write_callback_t>> write_hooks;
+
+        /* Pending events by due time. Events with the same time keep the order in which they were scheduled. */
+        std::multimap<cycles_t, callback_t> events;
+
+        cycles_t now = 0U;
+
+        /* Access counters, per register address and in total. */
+        std::unordered_map<utility::types::register_address_t, std::uint64_t> reads;
+        std::unordered_map<utility::types::register_address_t, std::uint64_t> writes;
+        std::uint64_t                                                         total_reads  = 0U;
+        std::uint64_t                                                         total_writes = 0U;
+    };
+
+    static auto simulation() -> state_t&
+    {
+        static state_t state;
+
+        return state;
+    }
+};
+
+}  // namespace tsri::backends
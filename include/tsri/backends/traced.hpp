@@ -0,0 +1,360 @@
+/**
+ * @file traced.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Trace of the register accesses in a ring buffer in RAM, to debug timing and bus traffic on the target.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Defining `TSRI_OPTION_TRACE` makes every register access that reaches a backend record an entry in `trace_buffer`.
+ * Without the option, no access is traced and the buffer is not compiled in. The buffer holds the last
+ * `TSRI_OPTION_TRACE_SIZE` entries (a power of two, default 256). Each entry is one 64-bit word:
+ * - bits 0-31: value that was read or written (the low 32 bits of wider registers);
+ * - bits 32-47: index of the register in the `trace_map` of its peripheral, or its offset if the peripheral has no
+ *   trace map;
+ * - bits 48-59: index of the peripheral in the SVD file, or `trace_map<>::unknown_peripheral`;
+ * - bits 60-63: `trace_kind` of the access.
+ *
+ * Recording claims a slot with one relaxed atomic increment and fills it with one 64-bit store, so it is lock-free and
+ * can be used from interrupt handlers. On cores without atomic read-modify-write instructions (e.g. Cortex-M0), the
+ * increment is a library call.
+ *
+ * The generator emits the trace maps with `--trace`. To decode a trace, dump the buffer, e.g. with GDB
+ * (`dump binary value trace.bin tsri::backends::trace_buffer`), and run `codegen/decode_trace.py trace.bin <svd file>`.
+ *
+ * The trace shows the accesses that reach the bus: with a register cache, reads that are served from the cache are not
+ * traced. Batched peripheral writes access the registers one by one while tracing. Init tables, which write absolute
+ * addresses, can not be built while tracing, see `init_table.hpp`.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+#include "write_type.hpp"
+
+#ifndef TSRI_OPTION_TRACE_SIZE
+#define TSRI_OPTION_TRACE_SIZE 256U
+#endif
+
+namespace tsri::backends
+{
+
+/**
+ * @brief Kind of register access in a trace entry.
+ */
+enum class trace_kind : std::uint8_t
+{
+    read,
+    write,
+    write_xor,
+    write_set,
+    write_clear,
+    /* Atomic modify by the backend, the value is the bits that were set. */
+    modify,
+    /* Atomic toggle by the backend, the value is the bits that were toggled. */
+    toggle
+};
+
+/**
+ * @brief Registers of the peripheral at `PeripheralBaseAddress`, to record register indices instead of addresses. By
+ * default the peripheral is unknown, and the offsets of its registers are recorded. Generated with `--trace`.
+ *
+ * @tparam PeripheralBaseAddress Base address of the peripheral.
+ */
+template<utility::types::register_address_t PeripheralBaseAddress>
+struct trace_map
+{
+    /* Peripheral index of peripherals that are not in the SVD file. */
+    static constexpr std::uint16_t unknown_peripheral = 0xFFFU;
+
+    /* Index of the peripheral in the SVD file. */
+    static constexpr std::uint16_t peripheral_index = unknown_peripheral;
+
+    /* Offsets of the registers, in ascending order. */
+    static constexpr std::array<utility::types::register_address_t, 0U> offsets{};
+};
+
+/**
+ * @brief Ring buffer with the trace entries. The header makes a dump of the buffer self-describing.
+ */
+struct trace_ring
+{
+    static_assert((TSRI_OPTION_TRACE_SIZE & (TSRI_OPTION_TRACE_SIZE - 1U)) == 0U,
+                  "TSRI_OPTION_TRACE_SIZE must be a power of two.");
+
+    /* "TSRT" in a little-endian word. */
+    static constexpr std::uint32_t trace_magic = 0x54525354U;
+
+    std::uint32_t magic = trace_magic;
+    /* Number of entries in the ring. */
+    std::uint32_t size = TSRI_OPTION_TRACE_SIZE;
+    /* Number of entries that were recorded, the oldest entry is at `position - size` if more than `size`. */
+    std::uint32_t position = 0U;
+    std::uint32_t reserved = 0U;
+
+    std::array<std::uint64_t, TSRI_OPTION_TRACE_SIZE> entries{};
+};
+
+/* Trace of the register accesses. Only takes memory if accesses are traced. */
+inline constinit trace_ring trace_buffer{};
+
+/**
+ * @brief Accesses registers through `Backend`, and records every access in `trace_buffer`.
+ *
+ * @tparam Backend Backend that performs the register accesses.
+ */
+template<typename Backend>
+class traced
+{
+public:
+    traced()                                 = delete;
+    traced(traced&&)                         = delete;
+    traced(const traced&)                    = delete;
+    auto operator=(traced&&) -> traced&      = delete;
+    auto operator=(const traced&) -> traced& = delete;
+    ~traced()                                = delete;
+
+    /**
+     * @brief Reads the register at `offset` from the peripheral base address, and records the value that was read.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @return Access Register value.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    [[nodiscard]] TSRI_INLINE static auto read(const utility::types::register_address_t offset) -> Access
+    {
+        const Access value = Backend::template read<PeripheralBaseAddress, Access>(offset);
+
+        record<PeripheralBaseAddress>(trace_kind::read, offset, value);
+
+        return value;
+    }
+
+    /**
+     * @brief Writes the register at `offset` from the peripheral base address, or one of its atomic aliases, and
+     * records the write.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam WriteType Type of the write.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param value Value to write.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        write_type                         WriteType = write_type::normal,
+        std::unsigned_integral             Access    = utility::types::register_value_t>
+    TSRI_INLINE static void write(const utility::types::register_address_t offset, const Access value)
+    {
+        Backend::template write<PeripheralBaseAddress, WriteType, Access>(offset, value);
+
+        record<PeripheralBaseAddress>(get_kind<WriteType>(), offset, value);
+    }
+
+    /**
+     * @brief Returns whether the atomic aliases of the peripheral are available in the backend, see `mapped.hpp`.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+        requires requires { Backend::template has_atomic_aliases<PeripheralBaseAddress>(); }
+    [[nodiscard]] TSRI_INLINE static auto has_atomic_aliases() noexcept -> bool
+    {
+        return Backend::template has_atomic_aliases<PeripheralBaseAddress>();
+    }
+
+    /**
+     * @brief Modifies the register with the atomic modify of the backend, see `mapped.hpp`.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+        requires requires(utility::types::register_address_t offset, Access mask) {
+            Backend::template modify<PeripheralBaseAddress, Access>(offset, mask, mask);
+        }
+    TSRI_INLINE static void modify(const utility::types::register_address_t offset,
+                                   const Access                             clear_mask,
+                                   const Access                             set_value)
+    {
+        Backend::template modify<PeripheralBaseAddress, Access>(offset, clear_mask, set_value);
+
+        record<PeripheralBaseAddress>(trace_kind::modify, offset, set_value);
+    }
+
+    /**
+     * @brief Toggles bits of the register with the atomic toggle of the backend, see `mapped.hpp`.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+        requires requires(utility::types::register_address_t offset, Access mask) {
+            Backend::template toggle<PeripheralBaseAddress, Access>(offset, mask, mask);
+        }
+    TSRI_INLINE static void toggle(const utility::types::register_address_t offset,
+                                   const Access                             toggle_mask,
+                                   const Access                             clear_mask)
+    {
+        Backend::template toggle<PeripheralBaseAddress, Access>(offset, toggle_mask, clear_mask);
+
+        record<PeripheralBaseAddress>(trace_kind::toggle, offset, toggle_mask);
+    }
+
+    /**
+     * @brief Reads the register and writes back part of it with the atomic read and write back of the backend, see
+     * `mapped.hpp`.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+        requires requires(utility::types::register_address_t offset, Access mask) {
+            Backend::template read_and_write_back<PeripheralBaseAddress, Access>(offset, mask);
+        }
+    TSRI_INLINE static auto read_and_write_back(const utility::types::register_address_t offset, const Access keep_mask)
+        -> Access
+    {
+        const Access value = Backend::template read_and_write_back<PeripheralBaseAddress, Access>(offset, keep_mask);
+
+        record<PeripheralBaseAddress>(trace_kind::read, offset, value);
+        record<PeripheralBaseAddress>(trace_kind::write, offset, value & keep_mask);
+
+        return value;
+    }
+
+    /**
+     * @brief Reads consecutive registers with a burst of the backend, see `transport.hpp`. Records a read per register.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+        requires requires(utility::types::register_address_t offset, std::span<Access> values) {
+            Backend::template read_burst<PeripheralBaseAddress, Access>(offset, values);
+        }
+    static void read_burst(const utility::types::register_address_t offset, const std::span<Access> values)
+    {
+        Backend::template read_burst<PeripheralBaseAddress, Access>(offset, values);
+
+        for (std::size_t index = 0U; index < values.size(); index++)
+        {
+            record<PeripheralBaseAddress>(trace_kind::read, offset + (index * sizeof(Access)), values[index]);
+        }
+    }
+
+    /**
+     * @brief Writes consecutive registers with a burst of the backend, see `transport.hpp`. Records a write per
+     * register.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+        requires requires(utility::types::register_address_t offset, std::span<const Access> values) {
+            Backend::template write_burst<PeripheralBaseAddress, Access>(offset, values);
+        }
+    static void write_burst(const utility::types::register_address_t offset, const std::span<const Access> values)
+    {
+        Backend::template write_burst<PeripheralBaseAddress, Access>(offset, values);
+
+        for (std::size_t index = 0U; index < values.size(); index++)
+        {
+            record<PeripheralBaseAddress>(trace_kind::write, offset + (index * sizeof(Access)), values[index]);
+        }
+    }
+
+private:
+    /**
+     * @brief Returns the trace kind of a write with `WriteType`.
+     */
+    template<write_type WriteType>
+    [[nodiscard]] static consteval auto get_kind() noexcept -> trace_kind
+    {
+        switch (WriteType)
+        {
+            case write_type::atomic_xor:
+                return trace_kind::write_xor;
+            case write_type::atomic_set:
+                return trace_kind::write_set;
+            case write_type::atomic_clear:
+                return trace_kind::write_clear;
+            default:
+                return trace_kind::write;
+        }
+    }
+
+    /**
+     * @brief Returns the index of the register at `offset` in the trace map, or the offset if it is not in the map.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    [[nodiscard]] TSRI_INLINE static constexpr auto get_register_index(
+        const utility::types::register_address_t offset) noexcept -> std::uint64_t
+    {
+        constexpr const auto& offsets = trace_map<PeripheralBaseAddress>::offsets;
+
+        for (std::size_t index = 0U; index < offsets.size(); index++)
+        {
+            if (offsets[index] == offset)
+            {
+                return index;
+            }
+        }
+
+        return offset;
+    }
+
+    /**
+     * @brief Records an access in the ring buffer: one atomic increment and one store.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    TSRI_INLINE static void record(const trace_kind                         kind,
+                                   const utility::types::register_address_t offset,
+                                   const std::uint64_t                      value) noexcept
+    {
+        record_entry(kind, get_register_tag<PeripheralBaseAddress>(offset), value);
+    }
+
+public:
+    /**
+     * @brief Returns the peripheral and register bits of the trace entries of the register at `offset`.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @param offset Offset from the peripheral base address.
+     * @return std::uint64_t Bits 32-59 of the trace entries of the register.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    [[nodiscard]] TSRI_INLINE static constexpr auto get_register_tag(
+        const utility::types::register_address_t offset) noexcept -> std::uint64_t
+    {
+        constexpr std::uint64_t peripheral_bits =
+            static_cast<std::uint64_t>(trace_map<PeripheralBaseAddress>::peripheral_index & 0xFFFU) << 48U;
+
+        return peripheral_bits | ((get_register_index<PeripheralBaseAddress>(offset) & 0xFFFFU) << 32U);
+    }
+
+    /**
+     * @brief Records an access of the register with `register_tag` in the ring buffer. Used by the shared access
+     * functions, which access the register by its address, see `shared_access.hpp`.
+     *
+     * @param kind Kind of access.
+     * @param register_tag Peripheral and register bits, see `get_register_tag`.
+     * @param value Value that was read or written.
+     */
+    TSRI_INLINE static void record_entry(const trace_kind    kind,
+                                         const std::uint64_t register_tag,
+                                         const std::uint64_t value) noexcept
+    {
+        const std::uint64_t entry = (static_cast<std::uint64_t>(kind) << 60U) | register_tag | (value & 0xFFFFFFFFU);
+
+        const std::uint32_t position =
+            std::atomic_ref<std::uint32_t>{ trace_buffer.position }.fetch_add(1U, std::memory_order_relaxed);
+
+        trace_buffer.entries[position & (TSRI_OPTION_TRACE_SIZE - 1U)] = entry;
+    }
+};
+
+}  // namespace tsri::backends
@@ -0,0 +1,262 @@
+/**
+ * @file transport.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Backend for registers of external devices that are accessed over a bus, such as I2C or SPI sensors.
+ * @version 0.1
+ * @date 2025-08-09
+ *
+ * The register map of an external chip can be described in an SVD file like any other peripheral. Its registers are
+ * not memory-mapped: every access is a transaction on a bus. The transport backend turns register accesses into
+ * transactions on a bus object, which is attached to the peripheral at runtime:
+ * @code
+ * template<>
+ * struct tsri::backends::peripheral_backend<SENSOR::base_address>
+ * {
+ *     using type = tsri::backends::transport<my_i2c_device>;
+ * };
+ *
+ * my_i2c_device sensor_device{ i2c1, 0x68U };
+ * tsri::backends::transport<my_i2c_device>::attach<SENSOR::base_address>(sensor_device);
+ * @endcode
+ *
+ * A bus object represents one device on the bus, e.g. an I2C controller and the address of the chip. It reads and
+ * writes bursts of bytes starting at a register address, which auto-increments within the burst like it does on most
+ * I2C and SPI devices. The base address of the peripheral only identifies the device, so every device needs its own
+ * base address in the SVD file.
+ *
+ * Each transaction has a fixed cost on a slow bus (start condition, device and register address), so operations on
+ * registers at adjacent addresses are coalesced into single bursts: `peripheral::read`, `peripheral::apply` and the
+ * saving and restoring of retained registers. Registers wider than a byte are transferred in the byte order of the
+ * device, big-endian by default.
+ *
+ * The `loopback_bus` keeps the registers in memory and counts the transactions, as a stand-in for a device in tests.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+#include "../utility/types.hpp"
+#include "write_type.hpp"
+
+namespace tsri::backends
+{
+
+/**
+ * @brief Checks if `Bus` can read and write bursts of bytes from and to the registers of a device.
+ */
+template<typename Bus>
+concept register_bus = requires(Bus&                                     bus,
+                                const utility::types::register_address_t address,
+                                const std::span<std::byte>               data,
+                                const std::span<const std::byte>         const_data) {
+    bus.read(address, data);
+    bus.write(address, const_data);
+};
+
+/**
+ * @brief Accesses registers with transactions on the bus that is attached to their peripheral.
+ * Writes to the atomic aliases are performed as a read transaction followed by a write transaction.
+ *
+ * @tparam Bus Bus of the device, see `register_bus`.
+ * @tparam ByteOrder Order in which the bytes of a register are transferred.
+ */
+template<register_bus Bus, std::endian ByteOrder = std::endian::big>
+class transport
+{
+public:
+    transport()                                    = delete;
+    transport(transport&&)                         = delete;
+    transport(const transport&)                    = delete;
+    auto operator=(transport&&) -> transport&      = delete;
+    auto operator=(const transport&) -> transport& = delete;
+    ~transport()                                   = delete;
+
+    /**
+     * @brief Makes the registers of the peripheral at `PeripheralBaseAddress` go through `bus`.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @param bus Bus of the device, which must outlive the accesses.
+     */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static void attach(Bus& bus) noexcept
+    {
+        attached_bus<PeripheralBaseAddress> = &bus;
+    }
+
+    /**
+     * @brief Reads the register at `offset` from the peripheral base address, in one transaction.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @return Access Register value.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    [[nodiscard]] static auto read(const utility::types::register_address_t offset) -> Access
+    {
+        Access value = 0U;
+
+        read_burst<PeripheralBaseAddress, Access>(offset, std::span{ &value, 1U });
+
+        return value;
+    }
+
+    /**
+     * @brief Writes the register at `offset` from the peripheral base address, in one transaction.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam WriteType Type of the write.
+     * @tparam Access Unsigned type with the width of the register.
+     * @param offset Offset from the peripheral base address.
+     * @param value Value to write.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        write_type                         WriteType = write_type::normal,
+        std::unsigned_integral             Access    = utility::types::register_value_t>
+    static void write(const utility::types::register_address_t offset, const Access value)
+    {
+        Access new_value = value;
+
+        if constexpr (WriteType == write_type::atomic_xor)
+        {
+            new_value = read<PeripheralBaseAddress, Access>(offset) ^ value;
+        }
+        else if constexpr (WriteType == write_type::atomic_set)
+        {
+            new_value = read<PeripheralBaseAddress, Access>(offset) | value;
+        }
+        else if constexpr (WriteType == write_type::atomic_clear)
+        {
+            new_value = read<PeripheralBaseAddress, Access>(offset) & static_cast<Access>(~value);
+        }
+
+        write_burst<PeripheralBaseAddress, Access>(offset, std::span{ &new_value, 1U });
+    }
+
+    /**
+     * @brief Reads consecutive registers of the same width, starting at `offset`, in one transaction.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the registers.
+     * @param offset Offset of the first register from the peripheral base address.
+     * @param values Values of the registers.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    static void read_burst(const utility::types::register_address_t offset, const std::span<Access> values)
+    {
+        const auto bytes = std::as_writable_bytes(values);
+
+        attached_bus<PeripheralBaseAddress>->read(offset, bytes);
+
+        convert_byte_order(bytes, sizeof(Access));
+    }
+
+    /**
+     * @brief Writes consecutive registers of the same width, starting at `offset`, in one transaction. Bursts of more
+     * than 64 bytes that need their byte order converted are split.
+     *
+     * @tparam PeripheralBaseAddress Base address of the peripheral.
+     * @tparam Access Unsigned type with the width of the registers.
+     * @param offset Offset of the first register from the peripheral base address.
+     * @param values Values to write.
+     */
+    template<
+        utility::types::register_address_t PeripheralBaseAddress,
+        std::unsigned_integral             Access = utility::types::register_value_t>
+    static void write_burst(const utility::types::register_address_t offset, const std::span<const Access> values)
+    {
+        if constexpr (sizeof(Access) == 1U or ByteOrder == std::endian::native)
+        {
+            attached_bus<PeripheralBaseAddress>->write(offset, std::as_bytes(values));
+        }
+        else
+        {
+            /* Bursts are short (a few registers of a sensor), a fixed buffer avoids allocating. */
+            static constexpr std::size_t buffer_size = 64U;
+
+            std::array<std::byte, buffer_size> buffer{};
+            std::size_t                        written = 0U;
+
+            while (written < values.size())
+            {
+                const std::size_t count = std::min(buffer_size / sizeof(Access), values.size() - written);
+                const auto        bytes = std::span{ buffer }.first(count * sizeof(Access));
+
+                std::ranges::copy(std::as_bytes(values.subspan(written, count)), bytes.begin());
+                convert_byte_order(bytes, sizeof(Access));
+
+                attached_bus<PeripheralBaseAddress>->write(offset + (written * sizeof(Access)), bytes);
+
+                written += count;
+            }
+        }
+    }
+
+private:
+    /* Bus of the peripheral at `PeripheralBaseAddress`, `nullptr` while it is not attached. */
+    template<utility::types::register_address_t PeripheralBaseAddress>
+    static inline constinit Bus* attached_bus = nullptr;
+
+    /**
+     * @brief Converts registers of `register_size` bytes between the native and the device byte order, in place.
+     */
+    static void convert_byte_order(const std::span<std::byte> bytes, const std::size_t register_size) noexcept
+    {
+        if constexpr (ByteOrder != std::endian::native)
+        {
+            for (std::size_t index = 0U; index < bytes.size(); index += register_size)
+            {
+                std::ranges::reverse(bytes.subspan(index, register_size));
+            }
+        }
+    }
+};
+
+/**
+ * @brief Device that keeps its registers in memory, to stand in for a device on a bus in tests.
+ *
+ * @tparam SizeInBytes Size of the register map of the device.
+ */
+template<std::size_t SizeInBytes>
+class loopback_bus
+{
+public:
+    /* Register map of the device. */
+    std::array<std::byte, SizeInBytes> memory{};
+
+    /* Number of read transactions. */
+    std::size_t reads = 0U;
+
+    /* Number of write transactions. */
+    std::size_t writes = 0U;
+
+    /**
+     * @brief Reads `data.size()` bytes, starting at register address `address`.
+     */
+    void read(const utility::types::register_address_t address, const std::span<std::byte> data) noexcept
+    {
+        std::ranges::copy(std::span{ memory }.subspan(address, data.size()), data.begin());
+        reads++;
+    }
+
+    /**
+     * @brief Writes `data.size()` bytes, starting at register address `address`.
+     */
+    void write(const utility::types::register_address_t address, const std::span<const std::byte> data) noexcept
+    {
+        std::ranges::copy(data, std::span{ memory }.subspan(address, data.size()).begin());
+        writes++;
+    }
+};
+
+}  // namespace tsri::backends
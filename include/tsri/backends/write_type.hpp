@@ -0,0 +1,46 @@
+/**
+ * @file write_type.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Types of register writes that backends must support.
+ * @version 0.1
+ * @date 2025-08-05
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "../utility/types.hpp"
+
+namespace tsri::backends
+{
+
+/**
+ * @brief Type of a register write. Atomic writes go to the register's atomic aliases, see Section 2.1.2 of the RP2040
+ * datasheet.
+ */
+enum class write_type : std::uint8_t
+{
+    normal,
+    atomic_xor,
+    atomic_set,
+    atomic_clear
+};
+
+/**
+ * @brief Address offset of the alias that performs a write of type `WriteType`, relative to the register address.
+ *
+ * @tparam WriteType Type of the write.
+ */
+template<write_type WriteType>
+inline constexpr utility::types::register_address_t alias_offset = 0x0000U;
+
+template<>
+inline constexpr utility::types::register_address_t alias_offset<write_type::atomic_xor> = 0x1000U;
+
+template<>
+inline constexpr utility::types::register_address_t alias_offset<write_type::atomic_set> = 0x2000U;
+
+template<>
+inline constexpr utility::types::register_address_t alias_offset<write_type::atomic_clear> = 0x3000U;
+
+}  // namespace tsri::backends
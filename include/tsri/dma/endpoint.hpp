@@ -0,0 +1,98 @@
+/**
+ * @file endpoint.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Registers as DMA sources and destinations.
+ * @version 0.1
+ * @date 2025-08-07
+ *
+ * A DMA channel that feeds a data register needs two things from it: its address, and the data request (DREQ) signal
+ * that paces the transfers. An endpoint bundles both, so the channel configuration can not pick up the address of one
+ * register and the DREQ of another:
+ * @code
+ * DMA::CH0_WRITE_ADDR::unsafe::set(PWM::WRAP0::address);
+ * DMA::CH0_CTRL_TRIG::set_fields(DMA::CH0_CTRL_TRIG::TREQ_SEL::value{ PWM::WRAP0::dreq }, ...);
+ * @endcode
+ *
+ * The SVD files do not contain the DREQ numbers. They are listed per peripheral in the overlay file of the generator,
+ * which generates an endpoint for each of them in the peripheral class, e.g. `PWM::WRAP0` for
+ * `{ "name": "WRAP0", "register": "CH0_CC", "dreq": 24 }`. See `codegen/helpers.py` for the format.
+ *
+ * `address` is the bus address of the register, which is what the DMA controller uses, whatever the backend of the
+ * peripheral. `get_pointer` is only available for backends that can hand out a pointer to the peripheral.
+ */
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+
+#include "../backends/backend.hpp"
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+
+namespace tsri::dma
+{
+
+/**
+ * @brief Checks if `Register` has an address, i.e. if it is a TSRI register.
+ */
+template<typename Register>
+concept addressable_register = requires {
+    { Register::address } -> std::convertible_to<utility::types::register_address_t>;
+    { Register::peripheral_base_address } -> std::convertible_to<utility::types::register_address_t>;
+};
+
+/**
+ * @brief Register used as source or destination of DMA transfers.
+ *
+ * @tparam Register Data register.
+ * @tparam DataRequest DREQ number that paces transfers to or from the register.
+ */
+template<addressable_register Register, std::uint32_t DataRequest>
+struct endpoint
+{
+private:
+    /* Backend of the peripheral that the register belongs to. */
+    using backend_t = backends::backend_t<Register::peripheral_base_address>;
+
+public:
+    endpoint()                                   = delete;
+    endpoint(endpoint&&)                         = delete;
+    endpoint(const endpoint&)                    = delete;
+    auto operator=(endpoint&&) -> endpoint&      = delete;
+    auto operator=(const endpoint&) -> endpoint& = delete;
+    ~endpoint()                                  = delete;
+
+    using register_t = Register;
+
+    /* Address of the register. */
+    static constexpr utility::types::register_address_t address = Register::address;
+
+    /* DREQ number of the register. */
+    static constexpr std::uint32_t dreq = DataRequest;
+
+    /**
+     * @brief Returns a pointer to the register through the base pointer of its backend, for DMA APIs that take pointers
+     * instead of addresses. Not available for backends without a base pointer, e.g. cached or traced peripherals,
+     * whose accesses must go through the backend.
+     *
+     * @return volatile utility::types::register_value_t* Pointer to the register.
+     */
+    [[nodiscard]] TSRI_INLINE static auto get_pointer() noexcept -> volatile utility::types::register_value_t*
+        requires requires { backend_t::template base_pointer<Register::peripheral_base_address>(); }
+    {
+        if constexpr (std::same_as<backend_t, backends::mmio>)
+        {
+            return std::bit_cast<volatile utility::types::register_value_t*>(address);
+        }
+        else
+        {
+            volatile unsigned char* const base = backend_t::template base_pointer<Register::peripheral_base_address>();
+
+            return reinterpret_cast<volatile utility::types::register_value_t*>(
+                base + (address - Register::peripheral_base_address));
+        }
+    }
+};
+
+}  // namespace tsri::dma
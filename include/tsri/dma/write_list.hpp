@@ -0,0 +1,92 @@
+/**
+ * @file write_list.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Register write sequences that are performed by DMA instead of the CPU.
+ * @version 0.1
+ * @date 2025-08-07
+ *
+ * A write list turns deferred register writes into a chain of DMA control blocks, which is built at compile time and
+ * placed in flash:
+ * @code
+ * static constexpr auto& blocks = tsri::dma::write_list<
+ *     PWM::CH0_CC::defer_set_fields_overwrite(PWM::CH0_CC::A::value{ 100U }),
+ *     PWM::CH1_CC::defer_set_fields_overwrite(PWM::CH1_CC::A::value{ 200U })
+ * >::control_blocks;
+ * @endcode
+ *
+ * Each control block is a pair of words: the address of the value to write, and the address of the register. The chain
+ * is ended by a block of zeros. On the RP2040, two channels run the chain:
+ * - The control channel copies one block (2 words, incrementing read) to `CHx_AL2_READ_ADDR` and
+ *   `CHx_AL2_WRITE_ADDR_TRIG` of the data channel, using a write ring of 8 bytes so each block lands on the same two
+ *   registers.
+ * - The data channel transfers one word without incrementing, and chains back to the control channel.
+ *
+ * The zero block writes a null trigger, which ends the chain without starting the data channel.
+ *
+ * Only overwriting writes (`defer_set_fields_overwrite`) can be used: DMA can not do a read-modify-write.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "../utility/types.hpp"
+
+namespace tsri::dma
+{
+
+/**
+ * @brief DMA control block that writes one register. Matches the layout of `CHx_AL2_READ_ADDR` followed by
+ * `CHx_AL2_WRITE_ADDR_TRIG` on 32-bit targets.
+ */
+struct control_block
+{
+    /* Address of the value to write, `nullptr` in the last block. */
+    const utility::types::register_value_t* read_address;
+    /* Address of the register, 0 in the last block (null trigger). */
+    utility::types::register_address_t write_address;
+};
+
+/**
+ * @brief Chain of control blocks that performs the given writes in order.
+ *
+ * @tparam Writes Overwriting deferred register writes.
+ */
+template<auto... Writes>
+class write_list
+{
+private:
+    static_assert(sizeof...(Writes) > 0U, "A write list needs at least one write.");
+    static_assert(((Writes.keep_mask == 0U) and ...), "DMA can only perform overwriting writes.");
+
+    /* Values of the writes. The control blocks point into this array. */
+    static constexpr std::array<utility::types::register_value_t, sizeof...(Writes)> values{ Writes.value... };
+
+public:
+    write_list()                                     = delete;
+    write_list(write_list&&)                         = delete;
+    write_list(const write_list&)                    = delete;
+    auto operator=(write_list&&) -> write_list&      = delete;
+    auto operator=(const write_list&) -> write_list& = delete;
+    ~write_list()                                    = delete;
+
+    /* Control blocks, one per write, followed by a null block. */
+    static constexpr auto control_blocks = []() {
+        std::array<control_block, sizeof...(Writes) + 1U> blocks{};
+        std::size_t                                       index = 0U;
+
+        (
+            [&]() {
+                blocks[index] = control_block{ .read_address  = &values[index],
+                                               .write_address = Writes.peripheral_base_address + Writes.address_offset };
+                index++;
+            }(),
+            ...);
+
+        blocks[index] = control_block{ .read_address = nullptr, .write_address = 0U };
+
+        return blocks;
+    }();
+};
+
+}  // namespace tsri::dma
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+
+namespace tsri::fields
+{
+
+/**
+ * @brief Contains a mask of bits inside a field. Used to pass many bits of a wide field at once, e.g. all GPIO pins
+ * that must be set, without building the mask from individual bit positions.
+ *
+ * @tparam ParentField Type of the field that is the parent of this bit mask.
+ */
+template<typename ParentField>
+class bit_mask_container
+{
+    /* Field needs to take the bit mask and shift it into the register position. And since we don't want to expose the
+     * stored mask to the user, we need to friend the `field` class.
+     */
+    friend ParentField;
+
+private:
+    /**
+     * @brief Checks if the bit mask container is inside `Field`. Same as for `bit_position_container`.
+     *
+     * @tparam Field Checks if mask container is inside this field.
+     */
+    template<typename Field>
+    static constexpr bool is_bit_mask_container_in_field = std::derived_from<Field, ParentField>;
+
+    /* Bit mask stored in the container, relative to the start bit of the field. */
+    utility::types::register_value_t stored_bit_mask = 0U;
+
+    /* Called when a constant bit mask does not fit in the field. Not `constexpr`, so it stops compilation. */
+    static void bit_mask_does_not_fit_in_field() noexcept {}
+
+public:
+    /**
+     * @brief Create a container for the `bit_mask`. This mask is **relative** to the start bit of the field, i.e. bit 0
+     * of the mask is the first bit of the field.
+     *
+     * If the container is created in a constant expression, e.g. as a `constexpr` variable, the mask is checked against
+     * the field: bits outside the field are a compile error. Otherwise, e.g. for a literal mask passed directly to a
+     * register function, the bits outside the field are dropped when the mask is shifted into the register.
+     *
+     * @tparam BitMask Type of the mask, must be an unsigned integral type.
+     * @param bit_mask Bit mask.
+     */
+    template<std::unsigned_integral BitMask>
+        requires (sizeof(BitMask) <= sizeof(utility::types::register_value_t))
+    TSRI_INLINE explicit constexpr bit_mask_container(const BitMask bit_mask) :
+        stored_bit_mask(static_cast<utility::types::register_value_t>(bit_mask))
+    {
+        if consteval
+        {
+            if ((stored_bit_mask & ~ParentField::get_bitmask_at_start()) != 0U)
+            {
+                bit_mask_does_not_fit_in_field();
+            }
+        }
+    }
+
+    bit_mask_container()                                             = delete;
+    bit_mask_container(bit_mask_container&&)                         = default;
+    bit_mask_container(const bit_mask_container&)                    = default;
+    auto operator=(bit_mask_container&&) -> bit_mask_container&      = default;
+    auto operator=(const bit_mask_container&) -> bit_mask_container& = default;
+    ~bit_mask_container()                                            = default;
+
+    /**
+     * @brief Combines two masks of the same field.
+     */
+    TSRI_INLINE constexpr friend auto operator|(const bit_mask_container& lhs, const bit_mask_container& rhs) noexcept
+        -> bit_mask_container
+    {
+        return bit_mask_container{ lhs.stored_bit_mask | rhs.stored_bit_mask };
+    }
+};
+
+}  // namespace tsri::fields
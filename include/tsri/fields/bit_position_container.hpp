@@ -4,6 +4,7 @@
 
 #include "../utility/inline_macro.hpp"
 #include "../utility/types.hpp"
+#include "bit_mask_container.hpp"
 
 namespace tsri::fields
 {
@@ -61,6 +62,36 @@ public:
     auto operator=(bit_position_container&&) -> bit_position_container&      = default;
     auto operator=(const bit_position_container&) -> bit_position_container& = default;
     ~bit_position_container()                                                = default;
+
+    /**
+     * @brief Combines two bit positions of the same field into a bit mask. With constant bit positions, such as the
+     * field's BIT0, BIT1, etc., the mask is computed at compile time.
+     */
+    TSRI_INLINE constexpr friend auto operator|(
+        const bit_position_container& lhs, const bit_position_container& rhs) noexcept -> bit_mask_container<ParentField>
+    {
+        return bit_mask_container<ParentField>{ (1U << lhs.stored_bit_position) | (1U << rhs.stored_bit_position) };
+    }
+
+    /**
+     * @brief Adds a bit position to a bit mask of the same field.
+     */
+    TSRI_INLINE constexpr friend auto operator|(
+        const bit_mask_container<ParentField>& lhs, const bit_position_container& rhs) noexcept
+        -> bit_mask_container<ParentField>
+    {
+        return lhs | bit_mask_container<ParentField>{ 1U << rhs.stored_bit_position };
+    }
+
+    /**
+     * @brief Adds a bit position to a bit mask of the same field.
+     */
+    TSRI_INLINE constexpr friend auto operator|(
+        const bit_position_container& lhs, const bit_mask_container<ParentField>& rhs) noexcept
+        -> bit_mask_container<ParentField>
+    {
+        return rhs | lhs;
+    }
 };
 
 }  // namespace tsri::fields
@@ -0,0 +1,157 @@
+/**
+ * @file bulk_decoder.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Decoding fields from large captures of register values on the host.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * A capture of a register, e.g. from `reg::sample_into`, is an array of raw register values. The `bulk_decoder` class
+ * extracts one or more fields from every value in a single pass over the capture, using the bitmasks and positions of
+ * the field definitions, so the decoder can not drift from the registers:
+ * @code
+ * std::vector<std::uint32_t> empty(capture.size());
+ * std::vector<std::uint32_t> level(capture.size());
+ *
+ * tsri::fields::bulk_decoder<ADC::FCS::EMPTY, ADC::FCS::LEVEL>::decode(capture, empty, level);
+ * @endcode
+ *
+ * With AVX2 (e.g. `-mavx2` or `-march=native`), eight values are decoded per instruction, with SSE2 four. Without
+ * either, and for the last few values of a capture, a scalar loop is used. Captures that do not fit in memory can be
+ * decoded in chunks of e.g. a million values.
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <span>
+
+#if defined(__AVX2__) or defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+#include "field.hpp"
+
+namespace tsri::fields
+{
+
+/**
+ * @brief Decodes the values of `Fields` from captured register values.
+ *
+ * @tparam Fields Readable fields of registers of at most 32 bits.
+ */
+template<typename... Fields>
+class bulk_decoder
+{
+private:
+    /* Type of a captured register value. */
+    using value_t = utility::types::register_value_t;
+
+    /* Type of the decoded values of one field. */
+    template<typename Field>
+    using output_t = std::span<value_t>;
+
+    static_assert(sizeof...(Fields) != 0U, "Decode at least one field.");
+    static_assert((Fields::is_readable and ...), "Only readable fields can be decoded.");
+    static_assert(
+        ((sizeof(typename Fields::register_value_type) <= sizeof(value_t)) and ...),
+        "Fields of registers wider than 32 bits can not be decoded.");
+
+    /* Position of the least significant bit of `Field` in its register. */
+    template<typename Field>
+    static constexpr int shift = std::countr_zero(Field::bitmask);
+
+    /* Bitmask of `Field`, shifted to bit 0. */
+    template<typename Field>
+    static constexpr value_t mask = Field::get_bitmask_at_start();
+
+public:
+    bulk_decoder()                                       = delete;
+    bulk_decoder(bulk_decoder&&)                         = delete;
+    bulk_decoder(const bulk_decoder&)                    = delete;
+    auto operator=(bulk_decoder&&) -> bulk_decoder&      = delete;
+    auto operator=(const bulk_decoder&) -> bulk_decoder& = delete;
+    ~bulk_decoder()                                      = delete;
+
+    /**
+     * @brief Writes the value of each field in `samples[i]` to `outputs[i]` of that field, in the order of `Fields`.
+     * The capture is read once, for all fields.
+     *
+     * @param samples Captured register values.
+     * @param outputs Buffers for the decoded values, one per field.
+     * @return std::size_t Number of values decoded: the size of the smallest of `samples` and `outputs`.
+     */
+    static auto decode(const std::span<const value_t> samples, const output_t<Fields>... outputs) noexcept
+        -> std::size_t
+    {
+        const std::size_t count = std::min({ samples.size(), outputs.size()... });
+        std::size_t       index = 0U;
+
+#if defined(__AVX2__)
+        for (; count - index >= 8U; index += 8U)
+        {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples.data() + index));
+
+            (decode_avx2<Fields>(value, outputs, index), ...);
+        }
+#endif
+
+#if defined(__SSE2__)
+        for (; count - index >= 4U; index += 4U)
+        {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples.data() + index));
+
+            (decode_sse2<Fields>(value, outputs, index), ...);
+        }
+#endif
+
+        for (; index < count; index++)
+        {
+            (decode_scalar<Fields>(samples[index], outputs, index), ...);
+        }
+
+        return count;
+    }
+
+private:
+#if defined(__AVX2__)
+    /**
+     * @brief Decodes `Field` from eight register values.
+     */
+    template<typename Field>
+    TSRI_INLINE static void decode_avx2(const __m256i value, const output_t<Field> output, const std::size_t index)
+    {
+        const __m256i field_value =
+            _mm256_and_si256(_mm256_srli_epi32(value, shift<Field>), _mm256_set1_epi32(static_cast<int>(mask<Field>)));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output.data() + index), field_value);
+    }
+#endif
+
+#if defined(__SSE2__)
+    /**
+     * @brief Decodes `Field` from four register values.
+     */
+    template<typename Field>
+    TSRI_INLINE static void decode_sse2(const __m128i value, const output_t<Field> output, const std::size_t index)
+    {
+        const __m128i field_value =
+            _mm_and_si128(_mm_srli_epi32(value, shift<Field>), _mm_set1_epi32(static_cast<int>(mask<Field>)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output.data() + index), field_value);
+    }
+#endif
+
+    /**
+     * @brief Decodes `Field` from one register value.
+     */
+    template<typename Field>
+    TSRI_INLINE static void decode_scalar(const value_t value, const output_t<Field> output, const std::size_t index)
+    {
+        output[index] = (value >> shift<Field>) & mask<Field>;
+    }
+};
+
+}  // namespace tsri::fields
@@ -7,13 +7,17 @@
  */
 #pragma once
 
+#include <bit>
 #include <climits>
 #include <concepts>
+#include <cstdint>
 #include <type_traits>
 
 // #include "../registers/register_read_write.hpp"
 #include "../registers/register_write_only.hpp"
+#include "../utility/bits.hpp"
 #include "../utility/types.hpp"
+#include "bit_mask_container.hpp"
 #include "bit_position_container.hpp"
 #include "field_types.hpp"
 #include "value_container.hpp"
@@ -26,10 +30,11 @@ namespace tsri::fields
  * All register classes need to make use of the fields, but we don't want to expose the user to all of its functions.
  * As such, the `field` class must befriend all register classes.
  *
- * This class exposes a grand total of three (3) things:
+ * This class exposes a grand total of four (4) things:
  *  1. `value_t`: the type of the field value. If it is an enum, this can be used to access its values.
  *  2. `bit_t`: the type of the field bits, this should be an `enum class`.
- *  3. `value_on_reset`: default value of the field after the processor resets. Can be used for e.g. setting the field
+ *  3. `mask`: the type of a mask of field bits, for passing many bits at once.
+ *  4. `value_on_reset`: default value of the field after the processor resets. Can be used for e.g. setting the field
  *     back to its reset value.
  *
  * @tparam StartBit     Start bit position in the register.
@@ -37,20 +42,28 @@ namespace tsri::fields
  * @tparam TypeOfField  Access type for the field.
  * @tparam FieldValueOnReset Reset value of the field.
  * @tparam RegisterAddress Address of the register that the field belongs to. Used to make each field type unique.
+ * @tparam SizeOfRegisterInBits Size of the register that the field belongs to, in bits. Field values are at most 32
+ * bits.
  */
 template<
     utility::types::register_size_t    StartBit,
     utility::types::register_size_t    LengthInBits,
     field_types::field_type            TypeOfField,
     utility::types::register_value_t   FieldValueOnReset,
-    utility::types::register_address_t RegisterAddress>
+    utility::types::register_address_t RegisterAddress,
+    utility::types::register_size_t    SizeOfRegisterInBits = 32U>
 class field
 {
+    static_assert(StartBit + LengthInBits <= SizeOfRegisterInBits, "Field does not fit in its register.");
+    static_assert(
+        LengthInBits <= sizeof(utility::types::register_value_t) * CHAR_BIT, "Field values are at most 32 bits.");
+
     /* Ayo this class has more friends than me... 🥲 */
 
     template<
         utility::types::register_address_t PeripheralBaseAddress,
         utility::types::register_address_t PeripheralBaseAddressOffset,
+        utility::types::register_size_t    RegisterSizeInBits,
         typename... RegisterFields>
         requires utility::concepts::are_types_unique_v<RegisterFields...>
     friend class registers::register_base;
@@ -58,34 +71,48 @@ class field
     template<
         utility::types::register_address_t PeripheralBaseAddress,
         utility::types::register_address_t PeripheralBaseAddressOffset,
+        utility::types::register_size_t    RegisterSizeInBits,
         typename... RegisterFields>
     friend class registers::register_read_only;
 
     template<
-        utility::types::register_address_t PeripheralBaseAddress,
-        utility::types::register_address_t PeripheralBaseAddressOffset,
-        utility::types::register_value_t   ValueOnReset,
+        utility::types::register_address_t                           PeripheralBaseAddress,
+        utility::types::register_address_t                           PeripheralBaseAddressOffset,
+        utility::types::register_size_t                              RegisterSizeInBits,
+        utility::types::register_value_of_size_t<RegisterSizeInBits> ValueOnReset,
         typename... RegisterFields>
     friend class registers::register_write_base;
 
     template<
-        utility::types::register_address_t PeripheralBaseAddress,
-        utility::types::register_address_t PeripheralBaseAddressOffset,
-        utility::types::register_value_t   ValueOnReset,
-        bool                               SupportsAtomicBitOperations,
+        utility::types::register_address_t                           PeripheralBaseAddress,
+        utility::types::register_address_t                           PeripheralBaseAddressOffset,
+        utility::types::register_size_t                              RegisterSizeInBits,
+        utility::types::register_value_of_size_t<RegisterSizeInBits> ValueOnReset,
+        bool                                                         SupportsAtomicBitOperations,
         typename... RegisterFields>
     friend class registers::register_write_only;
 
     template<
-        utility::types::register_address_t PeripheralBaseAddress,
-        utility::types::register_address_t PeripheralBaseAddressOffset,
-        utility::types::register_value_t   ValueOnReset,
-        bool                               SupportsAtomicBitOperations,
+        utility::types::register_address_t                           PeripheralBaseAddress,
+        utility::types::register_address_t                           PeripheralBaseAddressOffset,
+        utility::types::register_size_t                              RegisterSizeInBits,
+        utility::types::register_value_of_size_t<RegisterSizeInBits> ValueOnReset,
+        bool                                                         SupportsAtomicBitOperations,
         typename... RegisterFields>
     friend class registers::register_read_write;
 
 private:
-    using this_t = field<StartBit, LengthInBits, TypeOfField, FieldValueOnReset, RegisterAddress>;
+    using this_t = field<StartBit, LengthInBits, TypeOfField, FieldValueOnReset, RegisterAddress, SizeOfRegisterInBits>;
+
+    /* Type of the register value, which is what the field bitmasks are stored in. */
+    using register_value_type = utility::types::register_value_of_size_t<SizeOfRegisterInBits>;
+
+    /* Checks constant masks against the field bits. */
+    friend bit_mask_container<this_t>;
+
+    /* Decodes captured register values on the host. */
+    template<typename... Fields>
+    friend class bulk_decoder;
 
     /* Whether the field is readable. */
     static constexpr bool is_readable = field_types::is_readable<TypeOfField>;
@@ -105,16 +132,30 @@ private:
     /* Whether field can be toggled on the bit level. */
     static constexpr bool is_write_clear = std::is_same_v<TypeOfField, field_types::write_clear>;
 
+    /* Whether the field occupies exactly one byte or halfword lane of a wider register. */
+    static constexpr bool is_lane = (LengthInBits == 8U or LengthInBits == 16U) and (StartBit % LengthInBits == 0U) and
+                                    (LengthInBits < SizeOfRegisterInBits);
+
+    /* Type of a narrow store to the lane of the field. */
+    using lane_t = std::conditional_t<LengthInBits == 8U, std::uint8_t, std::uint16_t>;
+
+    /* Byte offset of the lane of the field from the register address. */
+    static constexpr utility::types::register_address_t lane_offset =
+        (std::endian::native == std::endian::little ? StartBit : SizeOfRegisterInBits - StartBit - LengthInBits) /
+        CHAR_BIT;
+
 protected:
     using bit = bit_position_container<this_t>;
 
+    using mask = bit_mask_container<this_t>;
+
     using value = value_container<this_t>;
 
 private:
     /**
      * @brief Bitmask of bit positions.
      */
-    utility::types::register_value_t stored_bitmask;
+    register_value_type stored_bitmask;
 
 public:
     /* Value of the field after processor reset. */
@@ -138,6 +179,20 @@ public:
         stored_bitmask(this_t::get_bitmask_from_bit_positions(containers.stored_bit_position...))
     {}
 
+    /**
+     * @brief Takes bit mask containers (of type mask) and shifts their combined mask to the field position in the
+     * register. The shift is done once, regardless of the number of bits in the mask. Bits of a runtime mask that do not
+     * fit in the field are dropped, so they can not spill into neighbouring fields.
+     *
+     * @tparam BitMaskContainer Bit mask containers.
+     */
+    template<typename... BitMaskContainer>
+        requires (sizeof...(BitMaskContainer) > 0U) and
+                 (BitMaskContainer::template is_bit_mask_container_in_field<this_t> and ...)
+    TSRI_INLINE constexpr explicit field(const BitMaskContainer&... containers) :
+        stored_bitmask((static_cast<register_value_type>((containers.stored_bit_mask | ...)) << StartBit) & bitmask)
+    {}
+
     field()                                = delete;
     field(field&&)                         = default;
     field(const field&)                    = default;
@@ -147,16 +202,15 @@ public:
 
 private:
     /* Bitmask of the field inside the register. */
-    static constexpr auto bitmask = []() -> utility::types::register_value_t {
-        static constexpr utility::types::register_value_t one_bits = ~0U;
+    static constexpr auto bitmask = []() -> register_value_type {
+        constexpr register_value_type one_bits = ~register_value_type{ 0U };
 
         /**
          * Right shift is done to get the correct \em number of bits required for the mask.
          * For example, if we want the mask 00111000, the right shift would be 8 - 3 = 5:
          * 11111111 >> 5 = 00000111
          */
-        static constexpr utility::types::register_size_t right_shift =
-            (sizeof(utility::types::register_value_t) * 8U) - LengthInBits;
+        constexpr utility::types::register_size_t right_shift = (sizeof(register_value_type) * 8U) - LengthInBits;
 
         /**
          * Left shift is done to put the number of bits acquired from the right shift in the correct \em position.
@@ -172,12 +226,13 @@ private:
      * Can be used in consteval context.
      *
      * @param value Value to insert into the field's position in its register.
-     * @return utility::types::register_value_t Value shifted and bitmasked into the field's position.
+     * @return register_value_type Value shifted and bitmasked into the field's position.
      */
     TSRI_INLINE static constexpr auto get_register_value_from_field_value(const value& value) noexcept
-        -> utility::types::register_value_t
+        -> register_value_type
     {
-        return (static_cast<utility::types::register_value_t>(value) << StartBit) & bitmask;
+        return (static_cast<register_value_type>(static_cast<utility::types::register_value_t>(value)) << StartBit) &
+               bitmask;
     }
 
     /**
@@ -186,10 +241,20 @@ private:
      * @param value Register value.
      * @return utility::types::register_value_t Field value.
      */
-    TSRI_INLINE static constexpr auto get_field_value_from_register_value(
-        const utility::types::register_value_t value) noexcept -> utility::types::register_value_t
+    TSRI_INLINE static constexpr auto get_field_value_from_register_value(const register_value_type value) noexcept
+        -> utility::types::register_value_t
     {
-        return (value & bitmask) >> StartBit;
+        /* Single bits are shifted first and masked with 1, which avoids loading a wide mask and maps to `bexti` on
+         * RISC-V cores with Zbs.
+         */
+        if constexpr (LengthInBits == 1U and std::same_as<register_value_type, utility::types::register_value_t>)
+        {
+            return utility::bits::extract_bit(value, StartBit);
+        }
+        else
+        {
+            return static_cast<utility::types::register_value_t>((value & bitmask) >> StartBit);
+        }
     }
 
     /**
@@ -200,9 +265,31 @@ private:
      * @return utility::types::register_value_t Field value..
      */
     TSRI_INLINE static constexpr auto get_field_value_from_register_value_no_bitmask(
-        const utility::types::register_value_t value) noexcept -> utility::types::register_value_t
+        const register_value_type value) noexcept -> utility::types::register_value_t
     {
-        return value >> StartBit;
+        return static_cast<utility::types::register_value_t>(value >> StartBit);
+    }
+
+    /**
+     * @brief Get the bitmask of the field, shifted to bit 0. Used to check bit masks.
+     *
+     * @return utility::types::register_value_t Bitmask of the field bits, starting at bit 0.
+     */
+    TSRI_INLINE static constexpr auto get_bitmask_at_start() noexcept -> utility::types::register_value_t
+    {
+        return static_cast<utility::types::register_value_t>(bitmask >> StartBit);
+    }
+
+    /**
+     * @brief Get the position of a bit of the field in its register.
+     *
+     * @param bit_position Bit position in the field.
+     * @return utility::types::register_size_t Bit position in the register.
+     */
+    TSRI_INLINE static constexpr auto get_bit_position_in_register(const bit& bit_position) noexcept
+        -> utility::types::register_size_t
+    {
+        return StartBit + bit_position.stored_bit_position;
     }
 
     /**
@@ -210,12 +297,12 @@ private:
      * The bit positions start at 0.
      *
      * @param bit_positions List of bit positions.
-     * @return utility::types::register_value_t
+     * @return register_value_type
      */
     TSRI_INLINE static constexpr auto get_bitmask_from_bit_positions(const std::unsigned_integral auto... bit_positions)
-        -> utility::types::register_value_t
+        -> register_value_type
     {
-        return ((1U << bit_positions) | ...) << StartBit;
+        return ((register_value_type{ 1U } << bit_positions) | ...) << StartBit;
     }
 };
 
@@ -5,6 +5,7 @@
 
 #include "../registers/register_read_write.hpp"
 #include "../registers/register_write_base.hpp"
+#include "../registers/register_write_only.hpp"
 
 namespace tsri::fields
 {
@@ -15,15 +16,33 @@ class value_container
     template<
         utility::types::register_address_t PeripheralBaseAddress,
         utility::types::register_address_t PeripheralBaseAddressOffset,
-        utility::types::register_value_t   ValueOnReset,
+        utility::types::register_size_t    RegisterSizeInBits,
+        typename... RegisterFields>
+    friend class registers::register_read_only;
+
+    template<
+        utility::types::register_address_t                           PeripheralBaseAddress,
+        utility::types::register_address_t                           PeripheralBaseAddressOffset,
+        utility::types::register_size_t                              RegisterSizeInBits,
+        utility::types::register_value_of_size_t<RegisterSizeInBits> ValueOnReset,
         typename... RegisterFields>
     friend class registers::register_write_base;
 
     template<
-        utility::types::register_address_t PeripheralBaseAddress,
-        utility::types::register_address_t PeripheralBaseAddressOffset,
-        utility::types::register_value_t   ValueOnReset,
-        bool                               SupportsAtomicBitOperations,
+        utility::types::register_address_t                           PeripheralBaseAddress,
+        utility::types::register_address_t                           PeripheralBaseAddressOffset,
+        utility::types::register_size_t                              RegisterSizeInBits,
+        utility::types::register_value_of_size_t<RegisterSizeInBits> ValueOnReset,
+        bool                                                         SupportsAtomicBitOperations,
+        typename... RegisterFields>
+    friend class registers::register_write_only;
+
+    template<
+        utility::types::register_address_t                           PeripheralBaseAddress,
+        utility::types::register_address_t                           PeripheralBaseAddressOffset,
+        utility::types::register_size_t                              RegisterSizeInBits,
+        utility::types::register_value_of_size_t<RegisterSizeInBits> ValueOnReset,
+        bool                                                         SupportsAtomicBitOperations,
         typename... RegisterFields>
     friend class registers::register_read_write;
 
@@ -0,0 +1,197 @@
+/**
+ * @file init_table.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Table-driven register initialization.
+ * @version 0.1
+ * @date 2025-08-02
+ *
+ * Every inlined `set_fields_overwrite` costs an address, a value and a store instruction. When a lot of registers are
+ * written during initialization, it is smaller to put the addresses and values in a table in flash and to apply the
+ * table with a single loop that is shared by all tables.
+ *
+ * Tables are built at compile time from deferred register writes:
+ * @code
+ * static constexpr auto& init = tsri::init::table<
+ *     PERIPH::CTRL::defer_set_fields_overwrite(PERIPH::CTRL::ENABLE::value::one),
+ *     PERIPH::INTR::defer_set_fields(PERIPH::INTR::EN::value::one)
+ * >;
+ *
+ * tsri::init::apply(init);
+ * @endcode
+ *
+ * The table describes the values that the registers end up with. All writes to the same register are combined in order,
+ * starting from the reset value of the register, and the register gets a single entry at the position of its last
+ * write. Registers that end up at their reset value are left out of the table. The other entries overwrite their
+ * register with the combined value, so applying the table does not read any register. This assumes that the table is
+ * applied while the registers still hold their reset values, which is the case for initialization code that runs right
+ * after the peripheral is reset.
+ *
+ * The entries hold absolute addresses and are applied through the default backend, bypassing the register cache and
+ * the trace. Tables can therefore only contain writes to peripherals whose backend is the default backend, which is
+ * checked at compile time. Peripherals with another backend, cached registers, or all peripherals when
+ * `TSRI_OPTION_TRACE` is defined, are initialized through their registers or `peripheral::apply` instead.
+ */
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+#include "../backends/backend.hpp"
+#include "../registers/register_write.hpp"
+#include "../utility/inline_macro.hpp"
+
+namespace tsri::init
+{
+
+/**
+ * @brief Single entry of an init table, equivalent to REG = (REG & keep_mask) | value.
+ * If `keep_mask` is 0, the register is only written.
+ */
+struct table_entry
+{
+    utility::types::register_address_t address;
+    utility::types::register_value_t   keep_mask;
+    utility::types::register_value_t   value;
+};
+
+namespace detail
+{
+
+/**
+ * @brief Deferred register write with the absolute address of its register.
+ */
+struct absolute_write
+{
+    utility::types::register_address_t address;
+    utility::types::register_value_t   keep_mask;
+    utility::types::register_value_t   value;
+    utility::types::register_value_t   value_on_reset;
+};
+
+/**
+ * @brief Entries of an init table, and the number of entries that are used.
+ *
+ * @tparam Size Maximum number of entries.
+ */
+template<std::size_t Size>
+struct folded_table
+{
+    std::array<table_entry, Size> entries;
+    std::size_t                   size;
+};
+
+/**
+ * @brief Combines the `writes` to each register in order, starting from the register's reset value. Each register that
+ * does not end up at its reset value gets one entry that overwrites it, at the position of its last write.
+ *
+ * @param writes Deferred register writes, in the order in which they are applied.
+ * @return folded_table<Size> Init table entries.
+ */
+template<std::size_t Size>
+[[nodiscard]] constexpr auto fold_writes(const std::array<absolute_write, Size>& writes) noexcept -> folded_table<Size>
+{
+    folded_table<Size> table{};
+
+    for (std::size_t index = 0U; index < Size; index++)
+    {
+        bool is_last_write = true;
+
+        for (std::size_t later = index + 1U; later < Size; later++)
+        {
+            is_last_write = is_last_write and writes[later].address != writes[index].address;
+        }
+
+        if (!is_last_write)
+        {
+            continue;
+        }
+
+        utility::types::register_value_t value = writes[index].value_on_reset;
+
+        for (std::size_t earlier = 0U; earlier <= index; earlier++)
+        {
+            if (writes[earlier].address == writes[index].address)
+            {
+                value = (value & writes[earlier].keep_mask) | writes[earlier].value;
+            }
+        }
+
+        if (value != writes[index].value_on_reset)
+        {
+            table.entries[table.size++] =
+                table_entry{ .address = writes[index].address, .keep_mask = 0U, .value = value };
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief `true` if the registers of the peripheral that `Write` belongs to are accessed through the default backend,
+ * so the write can be applied to its absolute address by `apply`.
+ *
+ * @tparam Write Deferred register write.
+ */
+template<auto Write>
+inline constexpr bool is_default_backend =
+    std::same_as<backends::backend_t<decltype(Write)::peripheral_base_address>, backends::default_backend>;
+
+}  // namespace detail
+
+/**
+ * @brief Init table that writes the values that the registers end up with after the `Writes`, starting from their reset
+ * values. Registers are written in the order of their last write.
+ *
+ * @tparam Writes Deferred register writes, created using the `defer_*` functions of the registers.
+ */
+template<auto... Writes>
+inline constexpr auto table = []() {
+    static_assert(
+        (detail::is_default_backend<Writes> and ...),
+        "Init tables bypass the peripheral backend, the register cache and the trace. Write to peripherals that do "
+        "not use the default backend through their registers or peripheral::apply.");
+
+    constexpr auto folded = detail::fold_writes(std::array<detail::absolute_write, sizeof...(Writes)>{
+        detail::absolute_write{ .address        = Writes.peripheral_base_address + Writes.address_offset,
+                                .keep_mask      = Writes.keep_mask,
+                                .value          = Writes.value,
+                                .value_on_reset = Writes.value_on_reset }... });
+
+    std::array<table_entry, folded.size> entries{};
+
+    for (std::size_t index = 0U; index < entries.size(); index++)
+    {
+        entries[index] = folded.entries[index];
+    }
+
+    return entries;
+}();
+
+/**
+ * @brief Applies the entries of an init table in order.
+ * This function is deliberately not inlined: all tables share the same loop, which is what saves the flash.
+ *
+ * @param entries Init table entries.
+ */
+TSRI_NOINLINE inline void apply(const std::span<const table_entry> entries) noexcept
+{
+    /* Entries hold absolute addresses, so they are accessed as offsets from address 0 through the default backend.
+     * `table` only accepts writes to peripherals that use the default backend. */
+    using backend_t = backends::default_backend;
+
+    for (const auto& entry : entries)
+    {
+        if (entry.keep_mask == 0U)
+        {
+            backend_t::write<0U>(entry.address, entry.value);
+        }
+        else
+        {
+            backend_t::write<0U>(entry.address, (backend_t::read<0U>(entry.address) & entry.keep_mask) | entry.value);
+        }
+    }
+}
+
+}  // namespace tsri::init
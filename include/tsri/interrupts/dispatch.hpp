@@ -0,0 +1,169 @@
+/**
+ * @file dispatch.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Dispatching interrupt status bits to handlers.
+ * @version 0.1
+ * @date 2025-08-06
+ *
+ * An interrupt handler typically reads an interrupt status register and then tests its bits one by one. The `dispatch`
+ * function of readable registers reads the status register once and only visits the bits that are set, calling the
+ * handler of each bit from a table that is built at compile time:
+ * @code
+ * void isr()
+ * {
+ *     PERIPH::INTS::dispatch<
+ *         tsri::interrupts::handler<PERIPH::INTS::RX, &on_receive>,
+ *         tsri::interrupts::handler<PERIPH::INTS::TX, &on_transmit>
+ *     >();
+ * }
+ * @endcode
+ *
+ * Handlers of single-bit fields take no arguments. Handlers of multi-bit fields are called once for each set bit of
+ * the field, with the position of the bit relative to the start of the field.
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "../utility/bits.hpp"
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+
+namespace tsri::interrupts
+{
+
+/**
+ * @brief Handler for the interrupt status bits in `Field`.
+ *
+ * @tparam Field Field of the status register.
+ * @tparam Function Function to call, either `void()` or `void(register_size_t bit)`.
+ */
+template<typename Field, auto Function>
+    requires std::invocable<decltype(Function)> or
+             std::invocable<decltype(Function), utility::types::register_size_t>
+struct handler
+{
+    using field_t = Field;
+
+    static constexpr auto function = Function;
+};
+
+/**
+ * @brief Table of handler calls, indexed by bit position in the status register.
+ *
+ * @tparam FieldBitmasks Bitmasks of the fields of `Handlers`, in the same order.
+ * @tparam Handlers Handlers.
+ */
+template<std::array FieldBitmasks, typename... Handlers>
+class dispatcher
+{
+public:
+    dispatcher()                                     = delete;
+    dispatcher(dispatcher&&)                         = delete;
+    dispatcher(const dispatcher&)                    = delete;
+    auto operator=(dispatcher&&) -> dispatcher&      = delete;
+    auto operator=(const dispatcher&) -> dispatcher& = delete;
+    ~dispatcher()                                    = delete;
+
+    /* All bits that have a handler. */
+    static constexpr utility::types::register_value_t handled_bitmask = []() {
+        utility::types::register_value_t bitmask = 0U;
+
+        for (const auto field_bitmask : FieldBitmasks)
+        {
+            bitmask |= field_bitmask;
+        }
+
+        return bitmask;
+    }();
+
+    /**
+     * @brief Calls the handlers of the bits that are set in `pending`.
+     *
+     * @param pending Pending interrupt bits, must be a subset of `handled_bitmask`.
+     */
+    TSRI_INLINE static void dispatch(const utility::types::register_value_t pending) noexcept
+    {
+        utility::bits::for_each_set_bit(pending, [](const utility::types::register_size_t bit) {
+            table[bit]();
+        });
+    }
+
+private:
+    static_assert(
+        []() {
+            utility::types::register_value_t bitmask = 0U;
+
+            for (const auto field_bitmask : FieldBitmasks)
+            {
+                if ((bitmask & field_bitmask) != 0U)
+                {
+                    return false;
+                }
+
+                bitmask |= field_bitmask;
+            }
+
+            return true;
+        }(),
+        "Handler fields must not overlap.");
+
+    /* Function in the table. */
+    using function_t = void (*)() noexcept;
+
+    /**
+     * @brief Calls the handler at `HandlerIndex` for bit `Bit` of the register.
+     *
+     * @tparam HandlerIndex Index of the handler.
+     * @tparam Bit Bit position in the register.
+     */
+    template<std::size_t HandlerIndex, utility::types::register_size_t Bit>
+    static void call() noexcept
+    {
+        using handler_t = std::tuple_element_t<HandlerIndex, std::tuple<Handlers...>>;
+
+        if constexpr (std::invocable<decltype(handler_t::function)>)
+        {
+            handler_t::function();
+        }
+        else
+        {
+            static constexpr auto start_bit =
+                static_cast<utility::types::register_size_t>(std::countr_zero(FieldBitmasks[HandlerIndex]));
+
+            handler_t::function(Bit - start_bit);
+        }
+    }
+
+    /**
+     * @brief Returns the table entry for bit `Bit`: the call to the handler whose field contains the bit, or `nullptr`.
+     *
+     * @tparam Bit Bit position in the register.
+     */
+    template<utility::types::register_size_t Bit>
+    static consteval auto get_table_entry() -> function_t
+    {
+        return []<std::size_t... HandlerIndices>(std::index_sequence<HandlerIndices...>) {
+            function_t entry = nullptr;
+
+            (((FieldBitmasks[HandlerIndices] >> Bit) & 1U ? static_cast<void>(entry = &call<HandlerIndices, Bit>)
+                                                           : static_cast<void>(0)),
+             ...);
+
+            return entry;
+        }(std::index_sequence_for<Handlers...>{});
+    }
+
+    /* Handler calls indexed by bit position, up to the highest bit that has a handler. */
+    static constexpr auto table = []<utility::types::register_size_t... Bits>(
+                                      std::integer_sequence<utility::types::register_size_t, Bits...>) {
+        return std::array<function_t, sizeof...(Bits)>{ get_table_entry<Bits>()... };
+    }(std::make_integer_sequence<utility::types::register_size_t, std::bit_width(handled_bitmask)>{});
+};
+
+}  // namespace tsri::interrupts
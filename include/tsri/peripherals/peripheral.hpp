@@ -0,0 +1,442 @@
+/**
+ * @file peripheral.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Base class for representation of peripherals.
+ * @version 0.1
+ * @date 2025-08-03
+ *
+ * Every generated peripheral inherits from the `peripheral` class, which provides operations on multiple registers of
+ * that peripheral at once.
+ */
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include "../backends/backend.hpp"
+#include "../registers/register_write.hpp"
+#include "../utility/inline_macro.hpp"
+#include "../utility/type_map.hpp"
+#include "../utility/types.hpp"
+
+namespace tsri::peripherals
+{
+
+/**
+ * @brief View on the registers of a peripheral: a base pointer and register offsets relative to that pointer.
+ * All registers accessed through the same view share the base pointer, so the compiler only has to materialize the
+ * base address once and can use immediate offsets for the individual loads and stores.
+ *
+ * If the backend of the peripheral cannot provide a base pointer, the view forwards the accesses to the backend.
+ * Consecutive registers are accessed in one transaction if the backend supports bursts, see `backends::transport`.
+ *
+ * @tparam PeripheralBaseAddress Base address of the peripheral.
+ */
+template<utility::types::register_address_t PeripheralBaseAddress>
+class peripheral_view
+{
+private:
+    /* Backend that performs the register accesses. */
+    using backend_t = backends::backend_t<PeripheralBaseAddress>;
+
+    /* Whether the backend provides a base pointer. */
+    static constexpr bool has_base_pointer = requires { backend_t::template base_pointer<PeripheralBaseAddress>(); };
+
+    /**
+     * @brief Returns the base pointer of the peripheral, if the backend has one.
+     *
+     * @return auto Pointer to the first byte of the peripheral, or `nullptr`.
+     */
+    [[nodiscard]] TSRI_INLINE static auto get_base_pointer() noexcept -> volatile unsigned char*
+    {
+        if constexpr (has_base_pointer)
+        {
+            return backend_t::template base_pointer<PeripheralBaseAddress>();
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    /* Pointer to the first byte of the peripheral. */
+    volatile unsigned char* base = get_base_pointer();
+
+public:
+    /* Whether the backend reads and writes consecutive registers in one transaction. */
+    static constexpr bool has_bursts = requires(
+        utility::types::register_address_t            offset,
+        std::span<utility::types::register_value_t>       values,
+        std::span<const utility::types::register_value_t> const_values) {
+        backend_t::template read_burst<PeripheralBaseAddress>(offset, values);
+        backend_t::template write_burst<PeripheralBaseAddress>(offset, const_values);
+    };
+
+    /**
+     * @brief Reads the register at `address_offset` from the peripheral base address.
+     *
+     * @param address_offset Offset from the peripheral base address.
+     * @return utility::types::register_value_t Register value.
+     */
+    [[nodiscard]] TSRI_INLINE auto read(const utility::types::register_address_t address_offset) const noexcept
+        -> utility::types::register_value_t
+    {
+        if constexpr (has_base_pointer)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): MMIO access through the base pointer.
+            return *reinterpret_cast<volatile utility::types::register_value_t*>(base + address_offset);
+        }
+        else
+        {
+            return backend_t::template read<PeripheralBaseAddress>(address_offset);
+        }
+    }
+
+    /**
+     * @brief Writes the register at `address_offset` from the peripheral base address.
+     *
+     * @param address_offset Offset from the peripheral base address.
+     * @param value Value to write.
+     */
+    TSRI_INLINE void write(
+        const utility::types::register_address_t address_offset,
+        const utility::types::register_value_t   value) const noexcept
+    {
+        if constexpr (has_base_pointer)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): MMIO access through the base pointer.
+            *reinterpret_cast<volatile utility::types::register_value_t*>(base + address_offset) = value;
+        }
+        else
+        {
+            backend_t::template write<PeripheralBaseAddress>(address_offset, value);
+        }
+    }
+
+    /**
+     * @brief Reads consecutive registers, starting at `address_offset`.
+     *
+     * @param address_offset Offset of the first register from the peripheral base address.
+     * @param values Values of the registers.
+     */
+    TSRI_INLINE void read(
+        const utility::types::register_address_t          address_offset,
+        const std::span<utility::types::register_value_t> values) const noexcept
+    {
+        if constexpr (has_bursts)
+        {
+            backend_t::template read_burst<PeripheralBaseAddress>(address_offset, values);
+        }
+        else
+        {
+            for (std::size_t index = 0U; index < values.size(); index++)
+            {
+                values[index] = read(address_offset + (index * sizeof(utility::types::register_value_t)));
+            }
+        }
+    }
+
+    /**
+     * @brief Writes consecutive registers, starting at `address_offset`.
+     *
+     * @param address_offset Offset of the first register from the peripheral base address.
+     * @param values Values to write.
+     */
+    TSRI_INLINE void write(
+        const utility::types::register_address_t                address_offset,
+        const std::span<const utility::types::register_value_t> values) const noexcept
+    {
+        if constexpr (has_bursts)
+        {
+            backend_t::template write_burst<PeripheralBaseAddress>(address_offset, values);
+        }
+        else
+        {
+            for (std::size_t index = 0U; index < values.size(); index++)
+            {
+                write(address_offset + (index * sizeof(utility::types::register_value_t)), values[index]);
+            }
+        }
+    }
+
+    /**
+     * @brief Performs a deferred register write relative to the base pointer.
+     *
+     * @param write Deferred register write of this peripheral.
+     */
+    TSRI_INLINE void apply(const registers::register_write<PeripheralBaseAddress>& register_write) const noexcept
+    {
+        if (register_write.keep_mask == 0U)
+        {
+            write(register_write.address_offset, register_write.value);
+        }
+        else
+        {
+            write(
+                register_write.address_offset,
+                (read(register_write.address_offset) & register_write.keep_mask) | register_write.value);
+        }
+    }
+};
+
+/**
+ * @brief Base class for peripheral representation.
+ *
+ * @tparam PeripheralBaseAddress Base address of the peripheral.
+ */
+template<utility::types::register_address_t PeripheralBaseAddress>
+class peripheral
+{
+public:
+    peripheral()                                     = delete;
+    peripheral(peripheral&&)                         = delete;
+    peripheral(const peripheral&)                    = delete;
+    auto operator=(peripheral&&) -> peripheral&      = delete;
+    auto operator=(const peripheral&) -> peripheral& = delete;
+    ~peripheral()                                    = delete;
+
+    /* Base address of the peripheral. */
+    static constexpr utility::types::register_address_t base_address = PeripheralBaseAddress;
+
+    /**
+     * @brief Performs the given deferred writes in order, loading the peripheral base address only once.
+     * The writes are created by the `defer_*` functions of the peripheral's registers:
+     * @code
+     * PERIPH::apply(
+     *     PERIPH::REG_A::defer_set_fields(PERIPH::REG_A::FIELD::value{ 4U }),
+     *     PERIPH::REG_B::defer_set_fields_overwrite(PERIPH::REG_B::FIELD::value::SOME_VALUE));
+     * @endcode
+     *
+     * @note Volatile accesses are never merged, so consecutive registers are still written with separate stores. If the
+     * backend supports bursts, writes to consecutive registers are coalesced into one read burst (only if a write
+     * keeps bits) and one write burst.
+     *
+     * @tparam Writes Deferred writes. All of them must belong to registers of this peripheral.
+     */
+    template<typename... Writes>
+        requires (std::same_as<Writes, registers::register_write<PeripheralBaseAddress>> and ...)
+    TSRI_INLINE static void apply(const Writes&... writes) noexcept
+    {
+        const peripheral_view<PeripheralBaseAddress> view;
+
+        if constexpr (peripheral_view<PeripheralBaseAddress>::has_bursts)
+        {
+            apply_in_bursts(view, std::array{ writes... });
+        }
+        else
+        {
+            (view.apply(writes), ...);
+        }
+    }
+
+    /**
+     * @brief Writes the registers that were changed in the register cache, if the peripheral has a write-back cache.
+     * See `backends::cached`.
+     */
+    static void sync() noexcept
+    {
+        using backend_t = backends::backend_t<PeripheralBaseAddress>;
+
+        if constexpr (requires { backend_t::template sync<PeripheralBaseAddress>(); })
+        {
+            backend_t::template sync<PeripheralBaseAddress>();
+        }
+    }
+
+    /**
+     * @brief Forgets the values in the register cache of the peripheral, e.g. after the device was reset. Writes that
+     * were not synced are dropped. See `backends::cached`.
+     */
+    static void invalidate() noexcept
+    {
+        using backend_t = backends::backend_t<PeripheralBaseAddress>;
+
+        if constexpr (requires { backend_t::template invalidate<PeripheralBaseAddress>(); })
+        {
+            backend_t::template invalidate<PeripheralBaseAddress>();
+        }
+    }
+
+    /**
+     * @brief Reads the given registers. If the backend supports bursts, registers of the same width at consecutive
+     * addresses are read in one transaction, e.g. the X, Y and Z data registers of a sensor:
+     * @code
+     * const auto data = SENSOR::read<SENSOR::OUT_X, SENSOR::OUT_Y, SENSOR::OUT_Z>();
+     * const auto x    = data.get<SENSOR::OUT_X>();
+     * @endcode
+     *
+     * @tparam Registers Readable registers of this peripheral, in order of their addresses to be coalesced.
+     * @return utility::types::type_map<Registers...> Values of the registers.
+     */
+    template<typename... Registers>
+        requires (sizeof...(Registers) > 0U) and
+                 ((Registers::address >= PeripheralBaseAddress and Registers::size <= 32U and
+                   requires { Registers::get(); }) and
+                  ...)
+    [[nodiscard]] TSRI_INLINE static auto read() noexcept -> utility::types::type_map<Registers...>
+    {
+        if constexpr (peripheral_view<PeripheralBaseAddress>::has_bursts)
+        {
+            const auto values = read_in_bursts<Registers...>();
+
+            return [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+                return utility::types::type_map<Registers...>{ values[Indices]... };
+            }(std::index_sequence_for<Registers...>{});
+        }
+        else
+        {
+            return utility::types::type_map<Registers...>{ static_cast<utility::types::register_value_t>(
+                Registers::get())... };
+        }
+    }
+
+private:
+    /**
+     * @brief Range of registers of the same width at consecutive addresses.
+     */
+    struct register_range
+    {
+        /* Index of the first register in the range. */
+        std::size_t first_index;
+        /* Number of registers in the range. */
+        std::size_t length;
+        /* Size of the registers in bits. */
+        utility::types::register_size_t size;
+    };
+
+    /**
+     * @brief Splits the registers at `offsets` with sizes `sizes` into ranges of consecutive registers.
+     *
+     * @return std::array<register_range, NumberOfRanges> Ranges, or their number if `NumberOfRanges` is 0.
+     */
+    template<std::size_t NumberOfRanges, std::size_t NumberOfRegisters>
+    static consteval auto get_ranges(const std::array<utility::types::register_address_t, NumberOfRegisters>& offsets,
+                                     const std::array<utility::types::register_size_t, NumberOfRegisters>&    sizes)
+    {
+        std::array<register_range, NumberOfRanges> ranges{};
+        std::size_t                                range = 0U;
+
+        for (std::size_t index = 0U; index < NumberOfRegisters; index++)
+        {
+            if (index != 0U and sizes[index] == sizes[index - 1U] and
+                offsets[index] == offsets[index - 1U] + (sizes[index] / 8U))
+            {
+                if constexpr (NumberOfRanges != 0U)
+                {
+                    ranges[range - 1U].length++;
+                }
+            }
+            else
+            {
+                if constexpr (NumberOfRanges != 0U)
+                {
+                    ranges[range] = register_range{ .first_index = index, .length = 1U, .size = sizes[index] };
+                }
+
+                range++;
+            }
+        }
+
+        if constexpr (NumberOfRanges == 0U)
+        {
+            return range;
+        }
+        else
+        {
+            return ranges;
+        }
+    }
+
+    /**
+     * @brief Reads the registers with one burst per range of consecutive registers.
+     *
+     * @tparam Registers Registers to read.
+     * @return std::array<utility::types::register_value_t, sizeof...(Registers)> Values of the registers.
+     */
+    template<typename... Registers>
+    TSRI_INLINE static auto read_in_bursts() noexcept
+        -> std::array<utility::types::register_value_t, sizeof...(Registers)>
+    {
+        static constexpr std::array<utility::types::register_address_t, sizeof...(Registers)> offsets{
+            (Registers::address - PeripheralBaseAddress)...
+        };
+        static constexpr std::array<utility::types::register_size_t, sizeof...(Registers)> sizes{ Registers::size... };
+        static constexpr auto ranges = get_ranges<get_ranges<0U>(offsets, sizes)>(offsets, sizes);
+
+        using backend_t = backends::backend_t<PeripheralBaseAddress>;
+
+        std::array<utility::types::register_value_t, sizeof...(Registers)> values{};
+
+        [&]<std::size_t... RangeIndices>(std::index_sequence<RangeIndices...>) {
+            (
+                [&]<register_range Range>() {
+                    using access_t = utility::types::register_access_t<Range.size>;
+
+                    std::array<access_t, Range.length> burst{};
+
+                    backend_t::template read_burst<PeripheralBaseAddress, access_t>(offsets[Range.first_index],
+                                                                                    std::span{ burst });
+
+                    for (std::size_t index = 0U; index < Range.length; index++)
+                    {
+                        values[Range.first_index + index] = burst[index];
+                    }
+                }.template operator()<ranges[RangeIndices]>(),
+                ...);
+        }(std::make_index_sequence<ranges.size()>{});
+
+        return values;
+    }
+
+    /**
+     * @brief Performs the deferred writes in order, with one burst per run of writes to consecutive registers.
+     *
+     * @param view View on the peripheral.
+     * @param writes Deferred writes.
+     */
+    template<std::size_t NumberOfWrites>
+    TSRI_INLINE static void apply_in_bursts(
+        const peripheral_view<PeripheralBaseAddress>&                                    view,
+        const std::array<registers::register_write<PeripheralBaseAddress>, NumberOfWrites>& writes) noexcept
+    {
+        std::array<utility::types::register_value_t, NumberOfWrites> values{};
+        std::size_t                                                  first = 0U;
+
+        while (first < NumberOfWrites)
+        {
+            std::size_t length    = 1U;
+            bool        keeps_bits = writes[first].keep_mask != 0U;
+
+            while (first + length < NumberOfWrites and
+                   writes[first + length].address_offset ==
+                       writes[first + length - 1U].address_offset + sizeof(utility::types::register_value_t))
+            {
+                keeps_bits = keeps_bits or writes[first + length].keep_mask != 0U;
+                length++;
+            }
+
+            const auto run = std::span{ values }.subspan(first, length);
+
+            if (keeps_bits)
+            {
+                view.read(writes[first].address_offset, run);
+            }
+
+            for (std::size_t index = 0U; index < length; index++)
+            {
+                const auto& write = writes[first + index];
+
+                run[index] = (run[index] & write.keep_mask) | write.value;
+            }
+
+            view.write(writes[first].address_offset, std::span<const utility::types::register_value_t>{ run });
+
+            first += length;
+        }
+    }
+};
+
+}  // namespace tsri::peripherals
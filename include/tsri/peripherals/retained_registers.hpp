@@ -0,0 +1,188 @@
+/**
+ * @file retained_registers.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Saving and restoring the configuration of a peripheral.
+ * @version 0.1
+ * @date 2025-08-03
+ *
+ * Before entering a low-power mode where peripherals lose their state, their configuration must be saved, so it can be
+ * restored afterwards. The code generator knows which registers hold configuration (only read-write and read-only
+ * fields) and passes their offsets to the `retained_registers` class, which every generated peripheral inherits from.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include "peripheral.hpp"
+#include "../registers/register_names.hpp"
+
+namespace tsri::peripherals
+{
+
+/**
+ * @brief Provides `save()` and `restore()` for the registers at the given offsets of a peripheral.
+ * The saved state is packed: it contains exactly one value per retained register.
+ *
+ * @tparam PeripheralBaseAddress Base address of the peripheral.
+ * @tparam RetainedRegisterOffsets Offsets of the retained registers from the base address, in ascending order.
+ */
+template<
+    utility::types::register_address_t PeripheralBaseAddress,
+    utility::types::register_address_t... RetainedRegisterOffsets>
+class retained_registers
+{
+public:
+    retained_registers()                                             = delete;
+    retained_registers(retained_registers&&)                         = delete;
+    retained_registers(const retained_registers&)                    = delete;
+    auto operator=(retained_registers&&) -> retained_registers&      = delete;
+    auto operator=(const retained_registers&) -> retained_registers& = delete;
+    ~retained_registers()                                            = delete;
+
+    /* Saved values of the retained registers, in the order of their offsets. */
+    using state = std::array<utility::types::register_value_t, sizeof...(RetainedRegisterOffsets)>;
+
+private:
+    /* Offsets of the retained registers, as an array so they can be iterated over at compile time. */
+    static constexpr std::array<utility::types::register_address_t, sizeof...(RetainedRegisterOffsets)> offsets{
+        RetainedRegisterOffsets...
+    };
+
+    /**
+     * @brief Range of registers at consecutive addresses.
+     */
+    struct register_range
+    {
+        /* Index of the first register in the range, in the state. */
+        std::size_t first_index;
+        /* Number of registers in the range. */
+        std::size_t length;
+    };
+
+    /* Number of ranges of consecutive registers. */
+    static constexpr std::size_t number_of_ranges = []() {
+        std::size_t ranges = 0U;
+
+        for (std::size_t index = 0U; index < offsets.size(); index++)
+        {
+            if (index == 0U or offsets[index] != offsets[index - 1U] + sizeof(utility::types::register_value_t))
+            {
+                ranges++;
+            }
+        }
+
+        return ranges;
+    }();
+
+    /* Ranges of consecutive registers. Each range is saved and restored with its own loop, or its own burst. */
+    static constexpr auto ranges = []() {
+        std::array<register_range, number_of_ranges> result{};
+        std::size_t                                  range = 0U;
+
+        for (std::size_t index = 0U; index < offsets.size(); index++)
+        {
+            if (index != 0U and offsets[index] == offsets[index - 1U] + sizeof(utility::types::register_value_t))
+            {
+                result[range - 1U].length++;
+            }
+            else
+            {
+                result[range++] = register_range{ .first_index = index, .length = 1U };
+            }
+        }
+
+        return result;
+    }();
+
+    static_assert(
+        []() {
+            for (std::size_t index = 1U; index < offsets.size(); index++)
+            {
+                if (offsets[index] <= offsets[index - 1U])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }(),
+        "Retained register offsets must be unique and in ascending order.");
+
+    /**
+     * @brief Calls `function` once for each range of consecutive registers, with the range as template argument.
+     * The ranges are iterated at compile time, so each range gets its own loop with constant bounds.
+     *
+     * @param function Function to call for each range.
+     */
+    TSRI_INLINE static void for_each_range(auto&& function) noexcept
+    {
+        [&]<std::size_t... RangeIndices>(std::index_sequence<RangeIndices...>) {
+            (function.template operator()<ranges[RangeIndices]>(), ...);
+        }(std::make_index_sequence<number_of_ranges>{});
+    }
+
+public:
+    /**
+     * @brief Reads all retained registers.
+     *
+     * @return state Saved values of the retained registers.
+     */
+    [[nodiscard]] TSRI_INLINE static auto save() noexcept -> state
+    {
+        const peripheral_view<PeripheralBaseAddress> view;
+        state                                        saved{};
+
+        for_each_range([&]<register_range Range>() {
+            view.read(offsets[Range.first_index], std::span{ saved }.subspan(Range.first_index, Range.length));
+        });
+
+        return saved;
+    }
+
+    /**
+     * @brief Writes the saved values back to the retained registers.
+     *
+     * @param saved Values returned by `save()`.
+     */
+    TSRI_INLINE static void restore(const state& saved) noexcept
+    {
+        const peripheral_view<PeripheralBaseAddress> view;
+
+        for_each_range([&]<register_range Range>() {
+            view.write(offsets[Range.first_index], std::span{ saved }.subspan(Range.first_index, Range.length));
+        });
+    }
+
+    /**
+     * @brief Formats the saved values with the names of the registers and their fields, one register after the other,
+     * see `registers::format`.
+     *
+     * @param saved Values returned by `save()`.
+     * @param buffer Buffer to write the text to.
+     * @return std::string_view Text in `buffer`, cut off if the buffer is too small.
+     */
+    [[nodiscard]] static constexpr auto format(const state& saved, const std::span<char> buffer) noexcept
+        -> std::string_view
+    {
+        registers::text_writer writer{ buffer };
+        std::size_t            index = 0U;
+
+        (
+            [&]() {
+                if (index != 0U)
+                {
+                    writer.append(' ');
+                }
+
+                registers::format_to<PeripheralBaseAddress + RetainedRegisterOffsets>(writer, saved[index++]);
+            }(),
+            ...);
+
+        return writer.text();
+    }
+};
+
+}  // namespace tsri::peripherals
@@ -0,0 +1,163 @@
+/**
+ * @file polling.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Polling policies for waiting on register conditions.
+ * @version 0.1
+ * @date 2025-08-04
+ *
+ * A polling policy decides what happens between two reads of a register that is being waited on: whether to keep
+ * waiting (timeouts) and what to do in the meantime (backoff). Latency-critical code can spin as hard as possible,
+ * while code that cares about power consumption can sleep until the next event or interrupt.
+ *
+ * Each policy has a `keep_waiting()` function, which is called after every read that did not satisfy the condition.
+ * It returns `false` when the wait has timed out. Waiting with a policy that can time out returns whether the condition
+ * was met, waiting with `spin` returns nothing, see `wait_result_t`.
+ */
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+#include "../utility/inline_macro.hpp"
+
+namespace tsri::polling
+{
+
+/**
+ * @brief Checks if `Policy` is a polling policy.
+ */
+template<typename Policy>
+concept policy = requires(Policy policy) {
+    { policy.keep_waiting() } -> std::same_as<bool>;
+};
+
+namespace backoff
+{
+
+/* Reads the register again immediately. */
+struct none
+{
+    TSRI_INLINE static void wait() noexcept {}
+};
+
+/* Sleeps until the next event (WFE on Arm). Make sure something sends an event, e.g. an interrupt. RISC-V has no
+ * events, so there the register is read again immediately: sleeping until an interrupt could hang on a condition that
+ * is not accompanied by one.
+ */
+struct wait_for_event
+{
+    TSRI_INLINE static void wait() noexcept
+    {
+#if defined(__arm__) or defined(__thumb__)
+        asm volatile("wfe");
+#endif
+    }
+};
+
+/* Sleeps until the next interrupt (WFI). Make sure the condition is accompanied by an interrupt. */
+struct wait_for_interrupt
+{
+    TSRI_INLINE static void wait() noexcept
+    {
+#if defined(__arm__) or defined(__thumb__) or defined(__riscv)
+        asm volatile("wfi");
+#endif
+    }
+};
+
+}  // namespace backoff
+
+/**
+ * @brief Waits forever. With the default backoff, this compiles to a loop of one load and one test.
+ *
+ * @tparam Backoff What to do between two reads.
+ */
+template<typename Backoff = backoff::none>
+struct spin
+{
+    TSRI_INLINE constexpr auto keep_waiting() noexcept -> bool
+    {
+        Backoff::wait();
+
+        return true;
+    }
+};
+
+/**
+ * @brief Gives up after the register has been read `count` times without satisfying the condition.
+ *
+ * @tparam Backoff What to do between two reads.
+ */
+template<typename Backoff = backoff::none>
+struct spin_count
+{
+    /* Number of reads that is still allowed to fail. */
+    std::uint32_t count;
+
+    TSRI_INLINE constexpr auto keep_waiting() noexcept -> bool
+    {
+        if (count == 0U)
+        {
+            return false;
+        }
+
+        count--;
+        Backoff::wait();
+
+        return true;
+    }
+};
+
+/**
+ * @brief Gives up after `timeout` ticks of `clock` have passed since the policy was created.
+ * The clock is a callable that returns the current time as an unsigned integer, e.g. a lambda that reads a timer
+ * register. Wrap-around of the clock is handled, as long as the timeout fits in the clock's range.
+ *
+ * @tparam Clock Callable that returns the current time.
+ * @tparam Backoff What to do between two reads.
+ */
+template<typename Clock, typename Backoff = backoff::none>
+    requires std::unsigned_integral<std::invoke_result_t<Clock&>>
+struct deadline
+{
+    /* Type of the time values returned by the clock. */
+    using time_t = std::invoke_result_t<Clock&>;
+
+    Clock  clock;
+    time_t timeout;
+    time_t start = clock();
+
+    TSRI_INLINE constexpr auto keep_waiting() noexcept -> bool
+    {
+        if (static_cast<time_t>(clock() - start) >= timeout)
+        {
+            return false;
+        }
+
+        Backoff::wait();
+
+        return true;
+    }
+};
+
+/**
+ * @brief `true` if `Policy` never gives up, so a wait with it always ends with the condition met.
+ *
+ * @tparam Policy Polling policy.
+ */
+template<typename Policy>
+inline constexpr bool waits_forever = false;
+
+template<typename Backoff>
+inline constexpr bool waits_forever<spin<Backoff>> = true;
+
+/**
+ * @brief Result of waiting with `Policy`: whether the condition was met, or nothing if the policy waits forever.
+ *
+ * @tparam Policy Polling policy.
+ */
+template<typename Policy>
+using wait_result_t = std::conditional_t<waits_forever<Policy>, void, bool>;
+
+}  // namespace tsri::polling
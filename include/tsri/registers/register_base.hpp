@@ -13,8 +13,12 @@
 #include <bit>
 #include <climits>
 #include <concepts>
+#include <cstdint>
 #include <type_traits>
 
+#include "../backends/backend.hpp"
+#include "shared_access.hpp"
+#include "usage_manifest.hpp"
 #include "../utility/concepts.hpp"
 #include "../utility/inline_macro.hpp"
 #include "../utility/types.hpp"
@@ -25,14 +29,17 @@ namespace tsri::registers
 /**
  * @brief Base class for hardware register representation.
  * Allows derived classes to read from and write to the register and its atomic counterparts (if supported).
+ * The accesses are performed by the backend of the peripheral, see `backends::peripheral_backend`.
  *
  * @tparam PeripheralBaseAddress        Base address of the peripheral.
  * @tparam PeripheralBaseAddressOffset  Offest from theh peripheral base address.
+ * @tparam RegisterSizeInBits           Size of the register in bits: 8, 16, 32 or 64.
  * @tparam RegisterFields               Fields inside the register.
  */
 template<
     utility::types::register_address_t PeripheralBaseAddress,
     utility::types::register_address_t PeripheralBaseAddressOffset,
+    utility::types::register_size_t    RegisterSizeInBits,
     typename... RegisterFields>
     requires utility::concepts::are_types_unique_v<RegisterFields...>
 class register_base
@@ -46,27 +53,51 @@ public:
     ~register_base()                                       = delete;
 
 private:
-    /* Address offset for the atomic XOR on write, see Section 2.1.2 of the RP2040 datasheet. */
-    static constexpr utility::types::register_address_t atomic_xor_offset = 0x1000U;
-    /* Address offset for the atomic bitmask set on write, see Section 2.1.2 of the RP2040 datasheet. */
-    static constexpr utility::types::register_address_t atomic_set_offset = 0x2000U;
-    /* Address offset for the atomic bitmask clear on write, see Section 2.1.2 of the RP2040 datasheet. */
-    static constexpr utility::types::register_address_t atomic_clear_offset = 0x3000U;
+    /* Backend that performs the register accesses. */
+    using backend_t = backends::backend_t<PeripheralBaseAddress>;
+
+    /* Type with the exact width of the register, so every access uses the native width of the peripheral. */
+    using access_t = utility::types::register_access_t<RegisterSizeInBits>;
+
+protected:
+    /* Type of the register value and masks. */
+    using value_t = utility::types::register_value_of_size_t<RegisterSizeInBits>;
+
+    /* Size of the register in bits. */
+    static constexpr utility::types::register_size_t register_size = RegisterSizeInBits;
+
+    /* Value with all bits of the register set. */
+    static constexpr value_t all_bits = static_cast<access_t>(~access_t{ 0U });
+
+    /* Whether the register is accessed directly through its memory address, without another backend in between. */
+    static constexpr bool is_memory_mapped = std::same_as<backend_t, backends::mmio>;
+
+    /* Whether fields that occupy a whole byte or halfword lane can be written with a narrow store. Only memory-mapped
+     * buses have lanes, other backends always get full-width accesses.
+     */
+    static constexpr bool supports_narrow_writes =
+        backends::peripheral_bus<PeripheralBaseAddress>::supports_narrow_writes and is_memory_mapped;
 
     /* Memory address of the register for normal read/write access. */
     static constexpr utility::types::register_address_t register_address =
         PeripheralBaseAddress + PeripheralBaseAddressOffset;
-    /* Memory address of the register's atomic xor on write. */
-    static constexpr utility::types::register_address_t register_address_atomic_xor =
-        register_address + atomic_xor_offset;
-    /* Memory address of the register's atomic bitmask set on write. */
-    static constexpr utility::types::register_address_t register_address_atomic_set =
-        register_address + atomic_set_offset;
-    /* Memory address of the register's atomic bitmask clear on write. */
-    static constexpr utility::types::register_address_t register_address_atomic_clear =
-        register_address + atomic_clear_offset;
 
-protected:
+    /**
+     * @brief Records a register operation at the call site in the usage manifest, see `usage_manifest.hpp`. Should be
+     * called once by every public register operation.
+     *
+     * @tparam Operation Register operation.
+     * @tparam Fields Fields that the operation touches, all fields of the register if none are given.
+     */
+    template<register_operation Operation, typename... Fields>
+    TSRI_INLINE static constexpr void record_usage() noexcept
+    {
+        static constexpr value_t fields_bitmask = sizeof...(Fields) == 0U ?
+                                                      (value_t{ 0U } | ... | RegisterFields::bitmask) :
+                                                      (value_t{ 0U } | ... | Fields::bitmask);
+
+        registers::record_usage<register_address, RegisterSizeInBits, fields_bitmask, Operation>();
+    }
 
     template<typename T, typename U>
     struct derived_from_or_same_condition
@@ -125,58 +156,285 @@ protected:
     static constexpr bool are_fields_bit_togglable = (Fields::is_bit_togglable and ...);
 
     /**
-     * @brief Returns a mutable reference to the hardware register, which should be used to write to the register in
-     * derived classes.
+     * @brief Reads the register, which should be used to read from the register in derived classes.
      *
-     * @return auto& Mutable reference to the register.
+     * @return value_t Register value.
      */
-    [[nodiscard]] TSRI_INLINE static auto reference() noexcept -> auto&
+    [[nodiscard]] TSRI_INLINE static auto read() noexcept -> value_t
     {
-        return *std::bit_cast<utility::types::register_ptr_t>(register_address);
+        return backend_t::template read<PeripheralBaseAddress, access_t>(PeripheralBaseAddressOffset);
     }
 
     /**
-     * @brief Returns a immutable reference to the hardware register, which should be used to read from the register in
-     * derived classes.
+     * @brief Writes the register, which should be used to write to the register in derived classes.
      *
-     * @return auto& Immutable reference to the register.
+     * @param value Value to write.
+     */
+    TSRI_INLINE static void write(const value_t value) noexcept
+    {
+        backend_t::template write<PeripheralBaseAddress, backends::write_type::normal, access_t>(
+            PeripheralBaseAddressOffset, static_cast<access_t>(value));
+    }
+
+    /* Whether the register is in the register cache, which keeps a copy of its value, see `backends::cached`. */
+    static constexpr bool is_cached =
+        requires { requires backend_t::template caches<PeripheralBaseAddress, PeripheralBaseAddressOffset>; };
+
+    /* Whether the backend modifies registers atomically, instead of with a separate read and write. */
+    static constexpr bool has_atomic_modify = requires(access_t mask) {
+        backend_t::template modify<PeripheralBaseAddress, access_t>(PeripheralBaseAddressOffset, mask, mask);
+        backend_t::template toggle<PeripheralBaseAddress, access_t>(PeripheralBaseAddressOffset, mask, mask);
+        backend_t::template read_and_write_back<PeripheralBaseAddress, access_t>(PeripheralBaseAddressOffset, mask);
+    };
+
+    /* Bits of the write-clear fields of the register. Read-modify-writes write them as 0, so they do not acknowledge
+     * pending bits that were read as 1.
      */
-    [[nodiscard]] TSRI_INLINE static auto const_reference() noexcept -> const auto&
+    static constexpr value_t write_clear_bits =
+        (value_t{ 0U } | ... | (RegisterFields::is_write_clear ? RegisterFields::bitmask : value_t{ 0U }));
+
+    /**
+     * @brief Returns `true` if atomic writes go to the atomic aliases of the register. Backends that emulate the
+     * aliases with `modify` and `toggle` can tell per peripheral whether the aliases are available, see `mapped.hpp`.
+     */
+    TSRI_INLINE static auto has_atomic_aliases() noexcept -> bool
     {
-        return *std::bit_cast<utility::types::register_ptr_t>(register_address);
+        if constexpr (requires { backend_t::template has_atomic_aliases<PeripheralBaseAddress>(); })
+        {
+            return backend_t::template has_atomic_aliases<PeripheralBaseAddress>();
+        }
+        else
+        {
+            return not has_atomic_modify;
+        }
+    }
+
+    /* Whether the shared access functions record the accesses of the register in the trace. */
+    static constexpr bool is_shared_access_traced = std::same_as<backend_t, shared::traced_backend_t>;
+
+    /* Whether the shared access functions can access the register: 32-bit registers of peripherals that use the default
+     * backend, traced or not, see `shared_access.hpp`.
+     */
+    static constexpr bool supports_shared_access =
+        (std::same_as<backend_t, backends::default_backend> or is_shared_access_traced) and (RegisterSizeInBits == 32U);
+
+    /**
+     * @brief `true` if operations with access mode `Mode` call the shared access functions, see `shared_access.hpp`.
+     * Fails to compile if `out_of_line` is passed explicitly for a register that does not support it.
+     *
+     * @tparam Mode Access mode.
+     */
+    template<access_mode Mode>
+    static constexpr bool is_shared_access = []() {
+        static_assert(not std::same_as<Mode, out_of_line_t> or supports_shared_access,
+                      "Out-of-line access is only supported for 32-bit registers of peripherals that use the default "
+                      "backend, without cached registers.");
+
+        return not std::same_as<Mode, inlined_t> and supports_shared_access;
+    }();
+
+    /* Trace bits of the register for the traced shared access functions. */
+    static constexpr std::uint64_t shared_access_tag = []() -> std::uint64_t {
+        if constexpr (is_shared_access_traced)
+        {
+            return backend_t::template get_register_tag<PeripheralBaseAddress>(PeripheralBaseAddressOffset);
+        }
+        else
+        {
+            return 0U;
+        }
+    }();
+
+    /**
+     * @brief Writes the register with the given access mode.
+     *
+     * @tparam Mode Access mode.
+     * @param value Value to write.
+     */
+    template<access_mode Mode>
+    TSRI_INLINE static void write(const value_t value) noexcept
+    {
+        if constexpr (is_shared_access<Mode>)
+        {
+            if constexpr (is_shared_access_traced)
+            {
+                shared::functions_t::traced_write(register_address, shared_access_tag, value);
+            }
+            else
+            {
+                shared::functions_t::write(register_address, value);
+            }
+        }
+        else
+        {
+            write(value);
+        }
+    }
+
+    /**
+     * @brief Clears the bits of `clear_mask` and sets the bits of `set_value` with a read-modify-write, using the given
+     * access mode. Backends that modify registers atomically perform the whole read-modify-write.
+     *
+     * @tparam Mode Access mode.
+     * @param clear_mask Bits to clear.
+     * @param set_value Bits to set.
+     */
+    template<access_mode Mode>
+    TSRI_INLINE static void modify(const value_t clear_mask, const value_t set_value) noexcept
+    {
+        if constexpr (is_shared_access<Mode>)
+        {
+            if constexpr (is_shared_access_traced)
+            {
+                shared::functions_t::traced_modify(
+                    register_address, shared_access_tag, clear_mask | write_clear_bits, set_value);
+            }
+            else
+            {
+                shared::functions_t::modify(register_address, clear_mask | write_clear_bits, set_value);
+            }
+        }
+        else if constexpr (has_atomic_modify)
+        {
+            backend_t::template modify<PeripheralBaseAddress, access_t>(
+                PeripheralBaseAddressOffset,
+                static_cast<access_t>(clear_mask | write_clear_bits),
+                static_cast<access_t>(set_value));
+        }
+        else
+        {
+            write((~(clear_mask | write_clear_bits) & read()) | set_value);
+        }
+    }
+
+    /**
+     * @brief Toggles the bits of `toggle_mask` with a read-modify-write, using the given access mode.
+     *
+     * @tparam Mode Access mode.
+     * @param toggle_mask Bits to toggle.
+     */
+    template<access_mode Mode>
+    TSRI_INLINE static void toggle(const value_t toggle_mask) noexcept
+    {
+        if constexpr (is_shared_access<Mode>)
+        {
+            if constexpr (is_shared_access_traced)
+            {
+                shared::functions_t::traced_toggle(register_address, shared_access_tag, toggle_mask, write_clear_bits);
+            }
+            else
+            {
+                shared::functions_t::toggle(register_address, toggle_mask, write_clear_bits);
+            }
+        }
+        else if constexpr (has_atomic_modify)
+        {
+            backend_t::template toggle<PeripheralBaseAddress, access_t>(PeripheralBaseAddressOffset,
+                                                                        static_cast<access_t>(toggle_mask),
+                                                                        static_cast<access_t>(write_clear_bits));
+        }
+        else
+        {
+            write((toggle_mask ^ read()) & ~write_clear_bits);
+        }
+    }
+
+    /**
+     * @brief Reads the register and writes back the bits of `keep_mask` of the value that was read, e.g. to acknowledge
+     * the write-clear bits that were read. Backends that modify registers atomically perform both accesses at once.
+     *
+     * @param keep_mask Bits of the value that was read to write back. The other bits are written as 0.
+     * @return value_t Value that was read.
+     */
+    TSRI_INLINE static auto read_and_write_back(const value_t keep_mask) noexcept -> value_t
+    {
+        if constexpr (has_atomic_modify)
+        {
+            return backend_t::template read_and_write_back<PeripheralBaseAddress, access_t>(
+                PeripheralBaseAddressOffset, static_cast<access_t>(keep_mask));
+        }
+        else
+        {
+            const value_t value = read();
+
+            write(value & keep_mask);
+
+            return value;
+        }
+    }
+
+    /**
+     * @brief Writes only the byte or halfword lane of `Field`, which should be used to write lane fields in derived
+     * classes when `supports_narrow_writes` is `true`. The other lanes of the register are not touched.
+     *
+     * @tparam Field Field that occupies exactly one lane of the register.
+     * @param field_value Value of the field, not shifted.
+     */
+    template<typename Field>
+        requires (Field::is_lane)
+    TSRI_INLINE static void write_lane(const utility::types::register_value_t field_value) noexcept
+    {
+        using lane_t = typename Field::lane_t;
+
+        backend_t::template write<PeripheralBaseAddress, backends::write_type::normal, lane_t>(
+            PeripheralBaseAddressOffset + Field::lane_offset, static_cast<lane_t>(field_value));
     }
 
     /**
-     * @brief Returns a mutable reference to the hardware register atomic xor on write, which should be used to write to
-     * atomically XOR bits in the register in derived classes.
+     * @brief Writes the register's atomic xor on write alias, which should be used to atomically XOR bits in the
+     * register in derived classes.
      *
-     * @return auto& Mutable reference to the atomic xor on write register.
+     * @param bitmask Bits to XOR.
      */
-    [[nodiscard]] TSRI_INLINE static auto atomic_xor_reference() noexcept -> auto&
+    TSRI_INLINE static void write_atomic_xor(const value_t bitmask) noexcept
     {
-        return *std::bit_cast<utility::types::register_ptr_t>(register_address_atomic_xor);
+        if (has_atomic_aliases())
+        {
+            backend_t::template write<PeripheralBaseAddress, backends::write_type::atomic_xor, access_t>(
+                PeripheralBaseAddressOffset, static_cast<access_t>(bitmask));
+        }
+        else
+        {
+            toggle<inlined_t>(bitmask);
+        }
     }
 
     /**
-     * @brief Returns a mutable reference to the hardware register atomic set bitmask on write, which should be used to
-     * write to atomically set bits in the register in derived classes.
+     * @brief Writes the register's atomic set bitmask on write alias, which should be used to atomically set bits in
+     * the register in derived classes.
      *
-     * @return auto& Mutable reference to the atomic set bitmask on write register.
+     * @param bitmask Bits to set.
      */
-    [[nodiscard]] TSRI_INLINE static auto atomic_set_reference() noexcept -> auto&
+    TSRI_INLINE static void write_atomic_set(const value_t bitmask) noexcept
     {
-        return *std::bit_cast<utility::types::register_ptr_t>(register_address_atomic_set);
+        if (has_atomic_aliases())
+        {
+            backend_t::template write<PeripheralBaseAddress, backends::write_type::atomic_set, access_t>(
+                PeripheralBaseAddressOffset, static_cast<access_t>(bitmask));
+        }
+        else
+        {
+            modify<inlined_t>(0U, bitmask);
+        }
     }
 
     /**
-     * @brief Returns a mutable reference to the hardware register atomic clear bitmask on write, which should be used
-     * to write to atomically clear bits in the register in derived classes.
+     * @brief Writes the register's atomic clear bitmask on write alias, which should be used to atomically clear bits
+     * in the register in derived classes.
      *
-     * @return auto& Mutable reference to the atomic clear bitmask on write register.
+     * @param bitmask Bits to clear.
      */
-    [[nodiscard]] TSRI_INLINE static auto atomic_clear_reference() noexcept -> auto&
+    TSRI_INLINE static void write_atomic_clear(const value_t bitmask) noexcept
     {
-        return *std::bit_cast<utility::types::register_ptr_t>(register_address_atomic_clear);
+        if (has_atomic_aliases())
+        {
+            backend_t::template write<PeripheralBaseAddress, backends::write_type::atomic_clear, access_t>(
+                PeripheralBaseAddressOffset, static_cast<access_t>(bitmask));
+        }
+        else
+        {
+            modify<inlined_t>(bitmask, 0U);
+        }
     }
 
     // NOLINTEND(readability-redundant-inline-specifier)
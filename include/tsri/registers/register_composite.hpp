@@ -0,0 +1,97 @@
+/**
+ * @file register_composite.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Consistent reads of counters that are split over two registers.
+ * @version 0.1
+ * @date 2025-08-08
+ *
+ * A 64-bit counter on a 32-bit bus is split over a low and a high register, e.g. TIMELR and TIMEHR of the RP2040 TIMER.
+ * Reading both halves separately is not consistent: the low half can overflow between the two reads. Devices solve
+ * this in one of two ways:
+ * - Reading the low register latches the high register, so reading low and then high is consistent. This is what the
+ *   RP2040 does for TIMELR/TIMEHR.
+ * - There is no latch. The high register is read before and after the low register, and the read is retried until both
+ *   high values are equal.
+ *
+ * Composite registers are generated from an overlay file, since the SVD files do not describe which registers belong
+ * together or how they must be read.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+
+namespace tsri::registers
+{
+
+/**
+ * @brief How the halves of a composite register are read consistently.
+ */
+enum class composite_read : std::uint8_t
+{
+    /* Reading the low register latches the high register. */
+    low_latches_high,
+    /* Read high, low, high, and retry if the high values differ. */
+    high_low_high
+};
+
+/**
+ * @brief Counter that is split over a low and a high register.
+ *
+ * @tparam LowRegister  Register with the low bits of the counter.
+ * @tparam HighRegister Register with the high bits of the counter.
+ * @tparam ReadOrder    How the halves are read consistently.
+ */
+template<typename LowRegister, typename HighRegister, composite_read ReadOrder>
+class register_composite
+{
+private:
+    static_assert(LowRegister::size + HighRegister::size <= 64U, "A composite register must fit in 64 bits.");
+
+public:
+    register_composite()                                             = delete;
+    register_composite(register_composite&&)                         = delete;
+    register_composite(const register_composite&)                    = delete;
+    auto operator=(register_composite&&) -> register_composite&      = delete;
+    auto operator=(const register_composite&) -> register_composite& = delete;
+    ~register_composite()                                            = delete;
+
+    /**
+     * @brief Reads both halves consistently and combines them.
+     * With a latch, this is exactly two loads: low, then high.
+     *
+     * @return std::uint64_t Value of the counter.
+     */
+    [[nodiscard]] TSRI_INLINE static auto read64() noexcept -> std::uint64_t
+    {
+        if constexpr (ReadOrder == composite_read::low_latches_high)
+        {
+            /* Separate statements, so the low register is always read first. */
+            const std::uint64_t low  = LowRegister::get();
+            const std::uint64_t high = HighRegister::get();
+
+            return (high << LowRegister::size) | low;
+        }
+        else
+        {
+            auto high = HighRegister::get();
+
+            while (true)
+            {
+                const std::uint64_t low       = LowRegister::get();
+                const auto          high_next = HighRegister::get();
+
+                if (high_next == high)
+                {
+                    return (static_cast<std::uint64_t>(high) << LowRegister::size) | low;
+                }
+
+                high = high_next;
+            }
+        }
+    }
+};
+
+}  // namespace tsri::registers
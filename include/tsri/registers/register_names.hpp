@@ -0,0 +1,261 @@
+/**
+ * @file register_names.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Names of registers, fields and enumerated values, and formatting of register values as text.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * The code generator emits a `register_names` table for every register with `--names`, from the same SVD file as the
+ * registers, so the names can not drift from the definitions. The tables are `constexpr`: they only take flash if
+ * `format` is used at runtime, and only for the registers that are formatted. Without `--names`, registers are
+ * formatted with their address and raw value, which can be decoded offline with the SVD file.
+ *
+ * `format` writes e.g. `CTRL{ENABLE=1, DIV=0x14, MODE=fast}` into a caller-provided buffer, without RTTI, heap or
+ * `printf`. Fields with an enumerated value are printed by name, other single-bit fields in decimal, and wider fields in
+ * hexadecimal. Output that does not fit in the buffer is cut off.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "../utility/types.hpp"
+
+namespace tsri::registers
+{
+
+/**
+ * @brief Name of an enumerated value of a field.
+ */
+struct enum_name
+{
+    /* Name of the value, as in `field::value`. */
+    std::string_view name;
+    /* Value of the field, not shifted. */
+    utility::types::register_value_t value;
+};
+
+/**
+ * @brief Name and position of a field.
+ */
+struct field_name
+{
+    /* Name of the field. */
+    std::string_view name;
+    /* Position of the least significant bit of the field in the register. */
+    std::uint8_t start_bit;
+    /* Number of bits in the field. */
+    std::uint8_t length_in_bits;
+    /* Index of the first enumerated value of the field in `register_names<>::enums`. */
+    std::uint16_t first_enum;
+    /* Number of enumerated values of the field. */
+    std::uint16_t number_of_enums;
+};
+
+/**
+ * @brief Names of the register at `RegisterAddress`, its fields and their enumerated values. By default the register
+ * has no names. Generated with `--names`.
+ *
+ * @tparam RegisterAddress Memory address of the register.
+ */
+template<utility::types::register_address_t RegisterAddress>
+struct register_names
+{
+    /* Name of the peripheral. */
+    static constexpr std::string_view peripheral{};
+
+    /* Name of the register. */
+    static constexpr std::string_view name{};
+
+    /* Fields of the register, in ascending order of their start bit. */
+    static constexpr std::array<field_name, 0U> fields{};
+
+    /* Enumerated values of all fields, grouped by field. */
+    static constexpr std::array<enum_name, 0U> enums{};
+};
+
+/**
+ * @brief Writes text into a fixed buffer. Text that does not fit is dropped.
+ */
+class text_writer
+{
+public:
+    /**
+     * @brief Creates a writer that writes to the start of `buffer`.
+     *
+     * @param output Buffer to write to.
+     */
+    constexpr explicit text_writer(const std::span<char> output) noexcept :
+        buffer(output)
+    {}
+
+    /**
+     * @brief Appends `text`.
+     */
+    constexpr void append(const std::string_view text) noexcept
+    {
+        for (const char character : text)
+        {
+            append(character);
+        }
+    }
+
+    /**
+     * @brief Appends a single character.
+     */
+    constexpr void append(const char character) noexcept
+    {
+        if (length < buffer.size())
+        {
+            buffer[length++] = character;
+        }
+    }
+
+    /**
+     * @brief Appends `value` in decimal.
+     */
+    constexpr void append_decimal(std::uint64_t value) noexcept
+    {
+        std::array<char, 20U> digits{};
+        std::size_t           count = 0U;
+
+        do
+        {
+            digits[count++] = static_cast<char>('0' + (value % 10U));
+            value /= 10U;
+        } while (value != 0U);
+
+        while (count != 0U)
+        {
+            append(digits[--count]);
+        }
+    }
+
+    /**
+     * @brief Appends `value` in hexadecimal, with a `0x` prefix and at least `minimum_digits` digits.
+     */
+    constexpr void append_hexadecimal(const std::uint64_t value, const std::size_t minimum_digits = 1U) noexcept
+    {
+        constexpr std::string_view hex_digits = "0123456789ABCDEF";
+
+        std::size_t digits = 16U;
+
+        while (digits > minimum_digits and (value >> ((digits - 1U) * 4U)) == 0U)
+        {
+            digits--;
+        }
+
+        append("0x");
+
+        while (digits != 0U)
+        {
+            digits--;
+            append(hex_digits[(value >> (digits * 4U)) & 0xFU]);
+        }
+    }
+
+    /**
+     * @brief Returns the text that was written.
+     */
+    [[nodiscard]] constexpr auto text() const noexcept -> std::string_view
+    {
+        return { buffer.data(), length };
+    }
+
+private:
+    std::span<char> buffer;
+    std::size_t     length = 0U;
+};
+
+/**
+ * @brief Writes `value` of the register at `RegisterAddress`, with the names of its fields, to `writer`.
+ *
+ * @tparam RegisterAddress Memory address of the register.
+ * @param writer Writer to write to.
+ * @param value Value of the register.
+ */
+template<utility::types::register_address_t RegisterAddress>
+constexpr void format_to(text_writer& writer, const std::uint64_t value) noexcept
+{
+    using names = register_names<RegisterAddress>;
+
+    if constexpr (names::name.empty())
+    {
+        writer.append_hexadecimal(RegisterAddress, 8U);
+        writer.append('{');
+        writer.append_hexadecimal(value);
+        writer.append('}');
+    }
+    else
+    {
+        writer.append(names::name);
+        writer.append('{');
+
+        for (std::size_t index = 0U; index < names::fields.size(); index++)
+        {
+            const field_name&   field = names::fields[index];
+            const std::uint64_t mask =
+                field.length_in_bits >= 64U ? ~std::uint64_t{ 0U } : (std::uint64_t{ 1U } << field.length_in_bits) - 1U;
+            const std::uint64_t field_value = (value >> field.start_bit) & mask;
+
+            if (index != 0U)
+            {
+                writer.append(", ");
+            }
+
+            writer.append(field.name);
+            writer.append('=');
+
+            std::string_view enum_value{};
+
+            for (std::size_t enum_index = field.first_enum; enum_index < field.first_enum + field.number_of_enums;
+                 enum_index++)
+            {
+                if (names::enums[enum_index].value == field_value)
+                {
+                    enum_value = names::enums[enum_index].name;
+                    break;
+                }
+            }
+
+            if (!enum_value.empty())
+            {
+                writer.append(enum_value);
+            }
+            else if (field.length_in_bits == 1U)
+            {
+                writer.append_decimal(field_value);
+            }
+            else
+            {
+                writer.append_hexadecimal(field_value);
+            }
+        }
+
+        writer.append('}');
+    }
+}
+
+/**
+ * @brief Formats `value` of `Register` with the names of its fields, e.g. `CTRL{ENABLE=1, DIV=0x14, MODE=fast}`.
+ *
+ * @tparam Register Register, e.g. `peripheral::reg`.
+ * @param value Value of the register, e.g. from `get()`.
+ * @param buffer Buffer to write the text to.
+ * @return std::string_view Text in `buffer`, cut off if the buffer is too small.
+ */
+template<typename Register>
+[[nodiscard]] constexpr auto format(const std::uint64_t value, const std::span<char> buffer) noexcept
+    -> std::string_view
+{
+    text_writer writer{ buffer };
+
+    format_to<Register::address>(writer, value);
+
+    return writer.text();
+}
+
+}  // namespace tsri::registers
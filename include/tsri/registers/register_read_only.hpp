@@ -9,6 +9,13 @@
  */
 #pragma once
 
+#include <array>
+#include <span>
+#include <utility>
+
+#include "../async/register_condition.hpp"
+#include "../interrupts/dispatch.hpp"
+#include "../polling/polling.hpp"
 #include "../registers/register_base.hpp"
 #include "../utility/type_map.hpp"
 
@@ -20,17 +27,24 @@ namespace tsri::registers
  *
  * @tparam PeripheralBaseAddress        Base address of the peripheral.
  * @tparam PeripheralBaseAddressOffset  Offest from theh peripheral base address.
+ * @tparam RegisterSizeInBits           Size of the register in bits: 8, 16, 32 or 64.
  * @tparam RegisterFields               Fields inside the register.
  */
 template<
     utility::types::register_address_t PeripheralBaseAddress,
     utility::types::register_address_t PeripheralBaseAddressOffset,
+    utility::types::register_size_t    RegisterSizeInBits,
     typename... RegisterFields>
-class register_read_only : register_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterFields...>
+class register_read_only :
+    register_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterSizeInBits, RegisterFields...>
 {
 private:
     /* Base class type. Used to access base class static methods. */
-    using base_t = register_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterFields...>;
+    using base_t =
+        register_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterSizeInBits, RegisterFields...>;
+
+    /* Type of the register value. */
+    using value_t = typename base_t::value_t;
 
 public:
     register_read_only()                                             = delete;
@@ -40,14 +54,52 @@ public:
     auto operator=(const register_read_only&) -> register_read_only& = delete;
     ~register_read_only()                                            = delete;
 
+    /* Memory address of the register, e.g. for use by DMA. */
+    static constexpr utility::types::register_address_t address = base_t::register_address;
+
+    /* Base address of the peripheral that the register belongs to, which selects its backend. */
+    static constexpr utility::types::register_address_t peripheral_base_address = PeripheralBaseAddress;
+
+    /* Size of the register in bits. */
+    static constexpr utility::types::register_size_t size = base_t::register_size;
+
     /**
      * @brief TODO:
      *
-     * @return utility::types::register_value_t
+     * @return value_t
+     */
+    [[nodiscard]] TSRI_INLINE static auto get() noexcept -> value_t
+    {
+        base_t::template record_usage<register_operation::get>();
+
+        return base_t::read();
+    }
+
+    /**
+     * @brief Reads the register back to back until `samples` is full, e.g. to capture a status register for offline
+     * decoding with `fields::bulk_decoder`. The loop is unrolled four times, so there is one loop branch per four reads.
+     *
+     * @param samples Buffer to read the register values into.
      */
-    [[nodiscard]] TSRI_INLINE static auto get() noexcept -> utility::types::register_value_t
+    TSRI_INLINE static void sample_into(const std::span<value_t> samples) noexcept
     {
-        return base_t::const_reference();
+        base_t::template record_usage<register_operation::sample>();
+
+        value_t*       sample = samples.data();
+        value_t* const end    = sample + samples.size();
+
+        for (; end - sample >= 4; sample += 4)
+        {
+            sample[0] = base_t::read();
+            sample[1] = base_t::read();
+            sample[2] = base_t::read();
+            sample[3] = base_t::read();
+        }
+
+        for (; sample != end; sample++)
+        {
+            *sample = base_t::read();
+        }
     }
 
     /**
@@ -58,7 +110,9 @@ public:
      */
     [[nodiscard]] TSRI_INLINE static constexpr auto is_any_bit_set() noexcept -> bool
     {
-        return base_t::const_reference() != 0U;
+        base_t::template record_usage<register_operation::test_bits>();
+
+        return base_t::read() != 0U;
     }
 
     /**
@@ -69,9 +123,9 @@ public:
      */
     [[nodiscard]] TSRI_INLINE static constexpr auto are_all_bits_set() noexcept -> bool
     {
-        static constexpr utility::types::register_value_t all_ones = ~0U;
+        base_t::template record_usage<register_operation::test_bits>();
 
-        return base_t::const_reference() == all_ones;
+        return base_t::read() == base_t::all_bits;
     }
 
     /**
@@ -89,7 +143,9 @@ public:
                  (base_t::template are_fields_readable<Fields...>)
     [[nodiscard]] TSRI_INLINE static constexpr auto get_fields() noexcept -> utility::types::type_map<Fields...>
     {
-        const utility::types::register_value_t register_value = base_t::const_reference();
+        base_t::template record_usage<register_operation::get_fields, Fields...>();
+
+        const value_t register_value = base_t::read();
 
         /* Optimization: if there is only one field in the register, do not use the field bitmask to get its value.
          * This can save one or two instructions, depending on the position of the field in the register.
@@ -120,9 +176,11 @@ public:
                  (base_t::template are_fields_readable<Fields...>)
     [[nodiscard]] TSRI_INLINE static constexpr auto is_any_bit_set(const Fields&&... fields) noexcept -> bool
     {
+        base_t::template record_usage<register_operation::test_bits, Fields...>();
+
         const auto bitmask = (fields.stored_bitmask | ...);
 
-        return (base_t::const_reference() & bitmask) != 0U;
+        return (base_t::read() & bitmask) != 0U;
     }
 
     /**
@@ -136,9 +194,328 @@ public:
                  (base_t::template are_fields_readable<Fields...>)
     [[nodiscard]] TSRI_INLINE static constexpr auto are_all_bits_set(const Fields&&... fields) noexcept -> bool
     {
+        base_t::template record_usage<register_operation::test_bits, Fields...>();
+
+        const auto bitmask = (fields.stored_bitmask | ...);
+
+        return (base_t::read() & bitmask) == bitmask;
+    }
+
+    /**
+     * @brief Reads the given fields until `predicate` returns `true` for their values, or until the polling policy
+     * gives up.
+     *
+     * @tparam Fields Fields to pass to the predicate.
+     * @param predicate Callable that takes the `utility::types::type_map` returned by `get_fields<Fields...>()`.
+     * @param policy Polling policy, decides on the timeout and backoff.
+     * @return true The predicate returned `true`.
+     * @return false The policy timed out. Nothing is returned for policies that wait forever, e.g. the default.
+     */
+    template<typename... Fields, polling::policy Policy = polling::spin<>>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>)
+    [[nodiscard]] TSRI_INLINE static constexpr auto wait_until(const auto& predicate, Policy policy = {}) noexcept
+        -> polling::wait_result_t<Policy>
+    {
+        base_t::template record_usage<register_operation::wait, Fields...>();
+
+        return wait(policy, [&](const value_t register_value) {
+            return predicate(
+                utility::types::type_map<Fields...>{ Fields::get_field_value_from_register_value(register_value)... });
+        });
+    }
+
+    /**
+     * @brief Waits until at least one of the given bits is set.
+     *
+     * @param policy Polling policy, decides on the timeout and backoff.
+     * @return true A bit was set.
+     * @return false The policy timed out. Nothing is returned for policies that wait forever.
+     */
+    template<polling::policy Policy, typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>)
+    [[nodiscard]] TSRI_INLINE static constexpr auto wait_until_any_bit_set(
+        Policy policy, const Fields&&... fields) noexcept -> polling::wait_result_t<Policy>
+    {
+        base_t::template record_usage<register_operation::wait, Fields...>();
+
+        const auto bitmask = (fields.stored_bitmask | ...);
+
+        return wait(policy, [=](const value_t register_value) {
+            return (register_value & bitmask) != 0U;
+        });
+    }
+
+    /**
+     * @brief Waits until all of the given bits are set.
+     *
+     * @param policy Polling policy, decides on the timeout and backoff.
+     * @return true All bits were set.
+     * @return false The policy timed out. Nothing is returned for policies that wait forever.
+     */
+    template<polling::policy Policy, typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>)
+    [[nodiscard]] TSRI_INLINE static constexpr auto wait_until_all_bits_set(
+        Policy policy, const Fields&&... fields) noexcept -> polling::wait_result_t<Policy>
+    {
+        base_t::template record_usage<register_operation::wait, Fields...>();
+
         const auto bitmask = (fields.stored_bitmask | ...);
 
-        return (base_t::const_reference() & bitmask) == bitmask;
+        return wait(policy, [=](const value_t register_value) {
+            return (register_value & bitmask) == bitmask;
+        });
+    }
+
+    /**
+     * @brief Waits until all of the given bits are cleared.
+     *
+     * @param policy Polling policy, decides on the timeout and backoff.
+     * @return true All bits were cleared.
+     * @return false The policy timed out. Nothing is returned for policies that wait forever.
+     */
+    template<polling::policy Policy, typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>)
+    [[nodiscard]] TSRI_INLINE static constexpr auto wait_until_all_bits_cleared(
+        Policy policy, const Fields&&... fields) noexcept -> polling::wait_result_t<Policy>
+    {
+        base_t::template record_usage<register_operation::wait, Fields...>();
+
+        const auto bitmask = (fields.stored_bitmask | ...);
+
+        return wait(policy, [=](const value_t register_value) {
+            return (register_value & bitmask) == 0U;
+        });
+    }
+
+    /**
+     * @brief Waits until all of the given fields have the given values.
+     *
+     * @param policy Polling policy, decides on the timeout and backoff.
+     * @return true All fields had their value.
+     * @return false The policy timed out. Nothing is returned for policies that wait forever.
+     */
+    template<polling::policy Policy, typename... Values>
+        requires utility::concepts::are_types_unique_v<typename Values::field_t...> and
+                 (base_t::template are_fields_in_register<typename Values::field_t...>) and
+                 (base_t::template are_fields_readable<typename Values::field_t...>)
+    [[nodiscard]] TSRI_INLINE static constexpr auto wait_until_fields_equal(
+        Policy policy, const Values&... values) noexcept -> polling::wait_result_t<Policy>
+    {
+        static constexpr auto fields_bitmask = (Values::field_t::bitmask | ...);
+
+        base_t::template record_usage<register_operation::wait, typename Values::field_t...>();
+
+        const auto field_values = (Values::field_t::get_register_value_from_field_value(values) | ...);
+
+        return wait(policy, [=](const value_t register_value) {
+            return (register_value & fields_bitmask) == field_values;
+        });
+    }
+
+    /* Same as the functions above, but waits forever without backoff. */
+
+    template<typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>)
+    TSRI_INLINE static constexpr void wait_until_any_bit_set(const Fields&&... fields) noexcept
+    {
+        wait_until_any_bit_set(polling::spin<>{}, std::move(fields)...);
+    }
+
+    template<typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>)
+    TSRI_INLINE static constexpr void wait_until_all_bits_set(const Fields&&... fields) noexcept
+    {
+        wait_until_all_bits_set(polling::spin<>{}, std::move(fields)...);
+    }
+
+    template<typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>)
+    TSRI_INLINE static constexpr void wait_until_all_bits_cleared(const Fields&&... fields) noexcept
+    {
+        wait_until_all_bits_cleared(polling::spin<>{}, std::move(fields)...);
+    }
+
+    template<typename... Values>
+        requires utility::concepts::are_types_unique_v<typename Values::field_t...> and
+                 (base_t::template are_fields_in_register<typename Values::field_t...>) and
+                 (base_t::template are_fields_readable<typename Values::field_t...>)
+    TSRI_INLINE static constexpr void wait_until_fields_equal(const Values&... values) noexcept
+    {
+        wait_until_fields_equal(polling::spin<>{}, values...);
+    }
+
+    /**
+     * @brief Reads the register once and calls the handler of each set bit, see `interrupts::dispatch`.
+     * Only the set bits are visited, so the cost depends on the number of pending interrupts instead of the number of
+     * handlers.
+     *
+     * @tparam Handlers Handlers (`interrupts::handler`) of the fields of this register.
+     * @return utility::types::register_value_t Bits that were handled.
+     */
+    template<typename... Handlers>
+        requires utility::concepts::are_types_unique_v<typename Handlers::field_t...> and
+                 (base_t::template are_fields_in_register<typename Handlers::field_t...>) and
+                 (base_t::template are_fields_readable<typename Handlers::field_t...>) and
+                 (RegisterSizeInBits <= 32U)
+    TSRI_INLINE static auto dispatch() noexcept -> utility::types::register_value_t
+    {
+        using dispatcher_t = dispatcher<Handlers...>;
+
+        base_t::template record_usage<register_operation::dispatch, typename Handlers::field_t...>();
+
+        const auto pending = base_t::read() & dispatcher_t::handled_bitmask;
+
+        dispatcher_t::dispatch(pending);
+
+        return pending;
+    }
+
+    /**
+     * @brief Creates a condition that can be awaited in an `async::task`, which is satisfied when all of the given
+     * fields have the given values.
+     *
+     * @return async::register_condition Awaitable condition.
+     */
+    template<typename... Values>
+        requires utility::concepts::are_types_unique_v<typename Values::field_t...> and
+                 (base_t::template are_fields_in_register<typename Values::field_t...>) and
+                 (base_t::template are_fields_readable<typename Values::field_t...>) and
+                 (RegisterSizeInBits <= 32U)
+    [[nodiscard]] TSRI_INLINE static constexpr auto until(const Values&... values) noexcept
+        -> async::register_condition
+    {
+        base_t::template record_usage<register_operation::wait, typename Values::field_t...>();
+
+        return create_condition(
+            (Values::field_t::bitmask | ...), (Values::field_t::get_register_value_from_field_value(values) | ...), true);
+    }
+
+    /**
+     * @brief Creates a condition that can be awaited in an `async::task`, which is satisfied when at least one of the
+     * given bits is set.
+     *
+     * @return async::register_condition Awaitable condition.
+     */
+    template<typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>) and (RegisterSizeInBits <= 32U)
+    [[nodiscard]] TSRI_INLINE static constexpr auto until_any_bit_set(const Fields&&... fields) noexcept
+        -> async::register_condition
+    {
+        base_t::template record_usage<register_operation::wait, Fields...>();
+
+        return create_condition((fields.stored_bitmask | ...), 0U, false);
+    }
+
+    /**
+     * @brief Creates a condition that can be awaited in an `async::task`, which is satisfied when all of the given bits
+     * are set.
+     *
+     * @return async::register_condition Awaitable condition.
+     */
+    template<typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>) and (RegisterSizeInBits <= 32U)
+    [[nodiscard]] TSRI_INLINE static constexpr auto until_all_bits_set(const Fields&&... fields) noexcept
+        -> async::register_condition
+    {
+        base_t::template record_usage<register_operation::wait, Fields...>();
+
+        const auto bitmask = (fields.stored_bitmask | ...);
+
+        return create_condition(bitmask, bitmask, true);
+    }
+
+    /**
+     * @brief Creates a condition that can be awaited in an `async::task`, which is satisfied when all of the given bits
+     * are cleared.
+     *
+     * @return async::register_condition Awaitable condition.
+     */
+    template<typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>) and (RegisterSizeInBits <= 32U)
+    [[nodiscard]] TSRI_INLINE static constexpr auto until_all_bits_cleared(const Fields&&... fields) noexcept
+        -> async::register_condition
+    {
+        base_t::template record_usage<register_operation::wait, Fields...>();
+
+        return create_condition((fields.stored_bitmask | ...), 0U, true);
+    }
+
+protected:
+    /* Dispatcher for the given handlers of this register. */
+    template<typename... Handlers>
+    using dispatcher = interrupts::dispatcher<
+        std::array<utility::types::register_value_t, sizeof...(Handlers)>{ Handlers::field_t::bitmask... },
+        Handlers...>;
+
+private:
+    /**
+     * @brief Reads the register until `condition` returns `true` for its value, or until `policy` gives up.
+     *
+     * @param policy Polling policy.
+     * @param condition Callable that takes the register value.
+     * @return true The condition was met.
+     * @return false The policy timed out. Nothing is returned for policies that wait forever.
+     */
+    template<polling::policy Policy>
+    TSRI_INLINE static constexpr auto wait(Policy& policy, const auto& condition) noexcept
+        -> polling::wait_result_t<Policy>
+    {
+        while (!condition(base_t::read()))
+        {
+            if constexpr (polling::waits_forever<Policy>)
+            {
+                policy.keep_waiting();
+            }
+            else if (!policy.keep_waiting())
+            {
+                return false;
+            }
+        }
+
+        if constexpr (not polling::waits_forever<Policy>)
+        {
+            return true;
+        }
+    }
+
+    /**
+     * @brief Creates a condition on this register.
+     *
+     * @param mask Bits of the register that are compared.
+     * @param expected Expected value of the compared bits.
+     * @param is_equal `true` if the bits must equal `expected`, `false` if they must differ from it.
+     * @return async::register_condition Awaitable condition.
+     */
+    TSRI_INLINE static constexpr auto create_condition(
+        const utility::types::register_value_t mask,
+        const utility::types::register_value_t expected,
+        const bool                             is_equal) noexcept -> async::register_condition
+    {
+        return async::register_condition{ .address  = base_t::register_address,
+                                          .read     = &register_read_only::get,
+                                          .mask     = mask,
+                                          .expected = expected,
+                                          .is_equal = is_equal };
     }
 };
 
@@ -9,8 +9,12 @@
  */
 #pragma once
 
+#include <utility>
+
+#include "../fields/bit_position_container.hpp"
 #include "../registers/register_read_only.hpp"
 #include "../registers/register_write_base.hpp"
+#include "../utility/bits.hpp"
 
 namespace tsri::registers
 {
@@ -20,24 +24,43 @@ namespace tsri::registers
  *
  * @tparam PeripheralBaseAddress        Base address of the peripheral.
  * @tparam PeripheralBaseAddressOffset  Offest from theh peripheral base address.
+ * @tparam RegisterSizeInBits           Size of the register in bits: 8, 16, 32 or 64.
  * @tparam ValueOnReset                 Value of the register after the CPU resets.
  * @tparam SupportsAtomicBitOperations  Whether the register supports atomic bit operations (xor, set, clear).
  * @tparam RegisterFields               Fields inside the register.
  */
 template<
-    utility::types::register_address_t PeripheralBaseAddress,
-    utility::types::register_address_t PeripheralBaseAddressOffset,
-    utility::types::register_value_t   ValueOnReset,
-    bool                               SupportsAtomicBitOperations,
+    utility::types::register_address_t                           PeripheralBaseAddress,
+    utility::types::register_address_t                           PeripheralBaseAddressOffset,
+    utility::types::register_size_t                              RegisterSizeInBits,
+    utility::types::register_value_of_size_t<RegisterSizeInBits> ValueOnReset,
+    bool                                                         SupportsAtomicBitOperations,
     typename... RegisterFields>
 class register_read_write :
-    public register_write_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, ValueOnReset, RegisterFields...>,
-    public register_read_only<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterFields...>
+    public register_write_base<
+        PeripheralBaseAddress,
+        PeripheralBaseAddressOffset,
+        RegisterSizeInBits,
+        ValueOnReset,
+        RegisterFields...>,
+    public register_read_only<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterSizeInBits, RegisterFields...>
 {
 private:
-    using base_t =
-        register_write_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, ValueOnReset, RegisterFields...>::
-            base_t;
+    using base_t = register_write_base<
+        PeripheralBaseAddress,
+        PeripheralBaseAddressOffset,
+        RegisterSizeInBits,
+        ValueOnReset,
+        RegisterFields...>::base_t;
+
+    /* Read-only base class type. Used to access the interrupt dispatcher. */
+    using read_only_t =
+        register_read_only<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterSizeInBits, RegisterFields...>;
+
+    /* Bits of the read-write fields, which keep their value when the register is written back. */
+    static constexpr typename base_t::value_t read_write_bitmask =
+        (typename base_t::value_t{ 0U } | ... |
+         (RegisterFields::is_bit_togglable ? RegisterFields::bitmask : typename base_t::value_t{ 0U }));
 
 public:
     register_read_write()                                              = delete;
@@ -47,10 +70,23 @@ public:
     auto operator=(const register_read_write&) -> register_read_write& = delete;
     ~register_read_write()                                             = delete;
 
+    /* Memory address of the register, e.g. for use by DMA. */
+    static constexpr utility::types::register_address_t address = base_t::register_address;
+
+    /* Base address of the peripheral that the register belongs to, which selects its backend. */
+    static constexpr utility::types::register_address_t peripheral_base_address = PeripheralBaseAddress;
+
+    /* Size of the register in bits. */
+    static constexpr utility::types::register_size_t size = base_t::register_size;
+
     /**
      * @brief Set provided fields to the provided values. Does not overwrite existing register data.
      * Equivalent to REG = value1 << shift1 | value2 << shift2 | ... | valueN << shiftN | (~bitmask & REG);
      *
+     * If a single field is set that occupies exactly one byte or halfword lane, and the bus of the peripheral supports
+     * narrow writes (see `backends::peripheral_bus`), the field is written with one narrow store instead of a
+     * read-modify-write. This also makes the update atomic. Out-of-line operations use the shared functions instead.
+     *
      * @tparam Values Values to set. Each value is associated with a field.
      */
     template<typename... Values>
@@ -59,12 +95,64 @@ public:
                   base_t::template are_fields_settable<typename Values::field_t...>)
     TSRI_INLINE static constexpr auto set_fields(const Values&... values) noexcept
     {
-        /* Register value needs to be cleared at the field positions. */
-        const auto cleared_register_value = ~(Values::field_t::bitmask | ...) & base_t::const_reference();
+        set_fields(default_access_t{}, values...);
+    }
+
+    /**
+     * @brief Same as `set_fields`, with the given access mode (`inlined` or `out_of_line`), see `shared_access.hpp`.
+     *
+     * @tparam Values Values to set. Each value is associated with a field.
+     */
+    template<access_mode Mode, typename... Values>
+        requires utility::concepts::are_types_unique_v<typename Values::field_t...> and
+                 (base_t::template are_fields_in_register<typename Values::field_t...> and
+                  base_t::template are_fields_settable<typename Values::field_t...>)
+    TSRI_INLINE static constexpr auto set_fields(const Mode /* mode */, const Values&... values) noexcept
+    {
+        base_t::template record_usage<register_operation::set_fields, typename Values::field_t...>();
 
+        /* Out-of-line operations call the shared functions, which may be placed in RAM, instead of the lane store. */
+        if constexpr (sizeof...(Values) == 1U and base_t::supports_narrow_writes and
+                      not base_t::template is_shared_access<Mode> and (Values::field_t::is_lane and ...))
+        {
+            (base_t::template write_lane<typename Values::field_t>(
+                 static_cast<utility::types::register_value_t>(values)),
+             ...);
+        }
+        else
+        {
+            /* Register value needs to be cleared at the field positions. */
+            static constexpr auto fields_bitmask = (Values::field_t::bitmask | ...);
+
+            const auto field_values = (Values::field_t::get_register_value_from_field_value(values) | ...);
+
+            base_t::template modify<Mode>(fields_bitmask, field_values);
+        }
+    }
+
+    /**
+     * @brief Describes a `set_fields` with the provided values, without writing to the register.
+     * The returned write can be applied later, for example as an entry of an init table.
+     *
+     * @tparam Values Values to set. Each value is associated with a field.
+     * @return register_write<PeripheralBaseAddress> Deferred write that keeps the bits outside the fields, except for
+     * the bits of write-clear fields, which are written with 0.
+     */
+    template<typename... Values>
+        requires utility::concepts::are_types_unique_v<typename Values::field_t...> and
+                 (base_t::template are_fields_in_register<typename Values::field_t...> and
+                  base_t::template are_fields_settable<typename Values::field_t...>) and
+                 (RegisterSizeInBits == 32U)
+    [[nodiscard]] TSRI_INLINE static constexpr auto defer_set_fields(const Values&... values) noexcept
+        -> register_write<PeripheralBaseAddress>
+    {
         const auto field_values = (Values::field_t::get_register_value_from_field_value(values) | ...);
 
-        base_t::reference() = field_values | cleared_register_value;
+        /* Write-clear bits are not kept, writing back a pending bit would acknowledge it. */
+        return { PeripheralBaseAddressOffset,
+                 ~((Values::field_t::bitmask | ...) | base_t::write_clear_bits),
+                 field_values,
+                 ValueOnReset };
     }
 
     /**
@@ -83,11 +171,27 @@ public:
                   base_t::template are_fields_clearable<Fields...>)
     TSRI_INLINE static constexpr auto clear_fields() noexcept
     {
+        clear_fields<Fields...>(default_access_t{});
+    }
+
+    /**
+     * @brief Same as `clear_fields`, with the given access mode (`inlined` or `out_of_line`), see `shared_access.hpp`.
+     *
+     * @tparam Fields Fields to clear.
+     */
+    template<typename... Fields, access_mode Mode>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...> and
+                  base_t::template are_fields_clearable<Fields...>)
+    TSRI_INLINE static constexpr auto clear_fields(const Mode /* mode */) noexcept
+    {
+        base_t::template record_usage<register_operation::clear_fields, Fields...>();
+
         static constexpr auto fields_bitmask = (Fields::bitmask | ...);
 
         if constexpr (SupportsAtomicBitOperations and !(Fields::is_write_clear or ...))
         {
-            base_t::atomic_clear_reference() = fields_bitmask;
+            base_t::write_atomic_clear(fields_bitmask);
         }
         else
         {
@@ -98,25 +202,107 @@ public:
             static constexpr auto fields_clear_value =
                 (Fields::get_register_value_from_field_value(static_cast<Fields::value>(Fields::clear_value)) | ...);
 
-            base_t::reference() = (~fields_bitmask & base_t::const_reference()) | fields_clear_value;
+            base_t::template modify<Mode>(fields_bitmask, fields_clear_value);
         }
     }
 
+    /**
+     * @brief Reads the register once and acknowledges the pending bits of the given write-clear fields, by writing
+     * exactly the bits that were read back to them. Bits that are set after the read are not acknowledged, so they can
+     * not get lost. Read-write fields are written back with the value that was read, the other fields with 0. With a
+     * backend that modifies registers atomically (see `mapped.hpp`), the read and the write are done under its lock.
+     * Replaces a `get_fields` followed by a `clear_fields`, which needs two reads and clears bits it has not seen.
+     *
+     * @tparam Fields Fields to return the values of. The write-clear fields among them are acknowledged.
+     * @return utility::types::type_map<Fields...> Values of the fields before they were acknowledged.
+     */
+    template<typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_readable<Fields...>) and (Fields::is_write_clear or ...)
+    [[nodiscard]] TSRI_INLINE static auto read_and_acknowledge() noexcept -> utility::types::type_map<Fields...>
+    {
+        static constexpr auto write_clear_bitmask = (0U | ... | (Fields::is_write_clear ? Fields::bitmask : 0U));
+
+        base_t::template record_usage<register_operation::acknowledge, Fields...>();
+
+        const auto register_value = base_t::read_and_write_back(read_write_bitmask | write_clear_bitmask);
+
+        return utility::types::type_map<Fields...>{ Fields::get_field_value_from_register_value(register_value)... };
+    }
+
+    /**
+     * @brief Same as `dispatch`, but afterwards acknowledges the handled bits of write-clear fields, by writing them
+     * back in a single store. Read-write fields are written back with the value that was read, the other fields with 0.
+     * With a backend that modifies registers atomically (see `mapped.hpp`), the read-write fields are written back with
+     * their current value under its lock instead.
+     *
+     * @note Handlers must not modify the read-write fields of this register, their changes would be overwritten, unless
+     * the backend modifies registers atomically.
+     *
+     * @tparam Handlers Handlers (`interrupts::handler`) of the fields of this register.
+     * @return utility::types::register_value_t Bits that were handled.
+     */
+    template<typename... Handlers>
+        requires utility::concepts::are_types_unique_v<typename Handlers::field_t...> and
+                 (base_t::template are_fields_in_register<typename Handlers::field_t...>) and
+                 (base_t::template are_fields_readable<typename Handlers::field_t...>) and
+                 (Handlers::field_t::is_write_clear or ...) and (RegisterSizeInBits <= 32U)
+    TSRI_INLINE static auto dispatch_and_acknowledge() noexcept -> utility::types::register_value_t
+    {
+        using dispatcher_t = typename read_only_t::template dispatcher<Handlers...>;
+
+        base_t::template record_usage<register_operation::acknowledge, typename Handlers::field_t...>();
+
+        static constexpr auto write_clear_bitmask =
+            (0U | ... | (Handlers::field_t::is_write_clear ? Handlers::field_t::bitmask : 0U));
+
+        const auto register_value = base_t::read();
+        const auto pending        = register_value & dispatcher_t::handled_bitmask;
+
+        dispatcher_t::dispatch(pending);
+
+        /* With a backend that modifies registers atomically, the read-write fields are written back with their current
+         * value under its lock, so changes by other threads while the handlers ran are kept.
+         */
+        if constexpr (base_t::has_atomic_modify)
+        {
+            base_t::template modify<inlined_t>(~read_write_bitmask, pending & write_clear_bitmask);
+        }
+        else
+        {
+            base_t::write((register_value & read_write_bitmask) | (pending & write_clear_bitmask));
+        }
+
+        return pending;
+    }
+
     template<typename... Fields>
         requires utility::concepts::are_types_unique_v<Fields...> and
                  (base_t::template are_fields_in_register<Fields...>) and
                  (base_t::template are_fields_settable<Fields...>)
     TSRI_INLINE static constexpr auto set_bits(const Fields&&... fields) noexcept
     {
+        set_bits(default_access_t{}, std::move(fields)...);
+    }
+
+    template<access_mode Mode, typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_settable<Fields...>)
+    TSRI_INLINE static constexpr auto set_bits(const Mode /* mode */, const Fields&&... fields) noexcept
+    {
+        base_t::template record_usage<register_operation::set_bits, Fields...>();
+
         const auto bitmask = (fields.stored_bitmask | ...);
 
         if constexpr (SupportsAtomicBitOperations)
         {
-            base_t::atomic_set_reference() = bitmask;
+            base_t::write_atomic_set(bitmask);
         }
         else
         {
-            base_t::reference() = bitmask | base_t::const_reference();
+            base_t::template modify<Mode>(bitmask, bitmask);
         }
     }
 
@@ -126,15 +312,26 @@ public:
                  (base_t::template are_fields_bit_clearable<Fields...>)
     TSRI_INLINE static constexpr auto clear_bits(const Fields&&... fields) noexcept
     {
+        clear_bits(default_access_t{}, std::move(fields)...);
+    }
+
+    template<access_mode Mode, typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_bit_clearable<Fields...>)
+    TSRI_INLINE static constexpr auto clear_bits(const Mode /* mode */, const Fields&&... fields) noexcept
+    {
+        base_t::template record_usage<register_operation::clear_bits, Fields...>();
+
         const auto bitmask = (fields.stored_bitmask | ...);
 
         if constexpr (SupportsAtomicBitOperations)
         {
-            base_t::atomic_clear_reference() = bitmask;
+            base_t::write_atomic_clear(bitmask);
         }
         else
         {
-            base_t::reference() = ~bitmask & base_t::const_reference();
+            base_t::template modify<Mode>(bitmask, 0U);
         }
     }
 
@@ -144,15 +341,145 @@ public:
                  (base_t::template are_fields_bit_togglable<Fields...>)
     TSRI_INLINE static constexpr auto toggle_bits(const Fields&&... fields) noexcept
     {
+        toggle_bits(default_access_t{}, std::move(fields)...);
+    }
+
+    template<access_mode Mode, typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>) and
+                 (base_t::template are_fields_bit_togglable<Fields...>)
+    TSRI_INLINE static constexpr auto toggle_bits(const Mode /* mode */, const Fields&&... fields) noexcept
+    {
+        base_t::template record_usage<register_operation::toggle_bits, Fields...>();
+
         const auto bitmask = (fields.stored_bitmask | ...);
 
         if constexpr (SupportsAtomicBitOperations)
         {
-            base_t::atomic_xor_reference() = bitmask;
+            base_t::write_atomic_xor(bitmask);
+        }
+        else
+        {
+            base_t::template toggle<Mode>(bitmask);
+        }
+    }
+
+    /**
+     * @brief Sets a single bit, whose position may only be known at runtime.
+     * On registers without atomic aliases, this is a read-modify-write like `set_bits`, in which the compiler emits one
+     * `bset` on RV32 cores with Zbs.
+     *
+     * @tparam Field Field that the bit belongs to.
+     * @param bit Bit of the field, e.g. `reg::field::bit{ n }`.
+     */
+    template<typename Field>
+        requires (base_t::template are_fields_in_register<Field>) and (base_t::template are_fields_settable<Field>) and
+                 (RegisterSizeInBits <= 32U)
+    TSRI_INLINE static void set_bit(const fields::bit_position_container<Field> bit) noexcept
+    {
+        set_bit(default_access_t{}, bit);
+    }
+
+    /**
+     * @brief Same as `set_bit`, with the given access mode (`inlined` or `out_of_line`), see `shared_access.hpp`.
+     *
+     * @tparam Field Field that the bit belongs to.
+     * @param bit Bit of the field, e.g. `reg::field::bit{ n }`.
+     */
+    template<access_mode Mode, typename Field>
+        requires (base_t::template are_fields_in_register<Field>) and (base_t::template are_fields_settable<Field>) and
+                 (RegisterSizeInBits <= 32U)
+    TSRI_INLINE static void set_bit(const Mode /* mode */, const fields::bit_position_container<Field> bit) noexcept
+    {
+        base_t::template record_usage<register_operation::set_bits, Field>();
+
+        const auto mask = utility::bits::set_bit(0U, Field::get_bit_position_in_register(bit));
+
+        if constexpr (SupportsAtomicBitOperations)
+        {
+            base_t::write_atomic_set(mask);
+        }
+        else
+        {
+            base_t::template modify<Mode>(mask, mask);
+        }
+    }
+
+    /**
+     * @brief Clears a single bit, whose position may only be known at runtime. Compiles to `bclr`, see `set_bit`.
+     *
+     * @tparam Field Field that the bit belongs to.
+     * @param bit Bit of the field, e.g. `reg::field::bit{ n }`.
+     */
+    template<typename Field>
+        requires (base_t::template are_fields_in_register<Field>) and
+                 (base_t::template are_fields_bit_clearable<Field>) and (RegisterSizeInBits <= 32U)
+    TSRI_INLINE static void clear_bit(const fields::bit_position_container<Field> bit) noexcept
+    {
+        clear_bit(default_access_t{}, bit);
+    }
+
+    /**
+     * @brief Same as `clear_bit`, with the given access mode (`inlined` or `out_of_line`), see `shared_access.hpp`.
+     *
+     * @tparam Field Field that the bit belongs to.
+     * @param bit Bit of the field, e.g. `reg::field::bit{ n }`.
+     */
+    template<access_mode Mode, typename Field>
+        requires (base_t::template are_fields_in_register<Field>) and
+                 (base_t::template are_fields_bit_clearable<Field>) and (RegisterSizeInBits <= 32U)
+    TSRI_INLINE static void clear_bit(const Mode /* mode */, const fields::bit_position_container<Field> bit) noexcept
+    {
+        base_t::template record_usage<register_operation::clear_bits, Field>();
+
+        const auto mask = utility::bits::set_bit(0U, Field::get_bit_position_in_register(bit));
+
+        if constexpr (SupportsAtomicBitOperations)
+        {
+            base_t::write_atomic_clear(mask);
+        }
+        else
+        {
+            base_t::template modify<Mode>(mask, 0U);
+        }
+    }
+
+    /**
+     * @brief Toggles a single bit, whose position may only be known at runtime. Compiles to `binv`, see `set_bit`.
+     *
+     * @tparam Field Field that the bit belongs to.
+     * @param bit Bit of the field, e.g. `reg::field::bit{ n }`.
+     */
+    template<typename Field>
+        requires (base_t::template are_fields_in_register<Field>) and
+                 (base_t::template are_fields_bit_togglable<Field>) and (RegisterSizeInBits <= 32U)
+    TSRI_INLINE static void toggle_bit(const fields::bit_position_container<Field> bit) noexcept
+    {
+        toggle_bit(default_access_t{}, bit);
+    }
+
+    /**
+     * @brief Same as `toggle_bit`, with the given access mode (`inlined` or `out_of_line`), see `shared_access.hpp`.
+     *
+     * @tparam Field Field that the bit belongs to.
+     * @param bit Bit of the field, e.g. `reg::field::bit{ n }`.
+     */
+    template<access_mode Mode, typename Field>
+        requires (base_t::template are_fields_in_register<Field>) and
+                 (base_t::template are_fields_bit_togglable<Field>) and (RegisterSizeInBits <= 32U)
+    TSRI_INLINE static void toggle_bit(const Mode /* mode */, const fields::bit_position_container<Field> bit) noexcept
+    {
+        base_t::template record_usage<register_operation::toggle_bits, Field>();
+
+        const auto mask = utility::bits::set_bit(0U, Field::get_bit_position_in_register(bit));
+
+        if constexpr (SupportsAtomicBitOperations)
+        {
+            base_t::write_atomic_xor(mask);
         }
         else
         {
-            base_t::reference() = bitmask ^ base_t::const_reference();
+            base_t::template toggle<Mode>(mask);
         }
     }
 };
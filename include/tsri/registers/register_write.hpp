@@ -0,0 +1,55 @@
+/**
+ * @file register_write.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Describes a register write without performing it.
+ * @version 0.1
+ * @date 2025-08-02
+ *
+ * A `register_write` is the result of calling one of the `defer_*` functions on a register. It holds everything that
+ * is needed to perform the write later on: where to write, which bits of the current register value to keep and which
+ * bits to write. Because all members are public, a `register_write` can be used as a template argument, which is what
+ * the init tables use to build their tables at compile time.
+ */
+#pragma once
+
+#include "../utility/types.hpp"
+
+namespace tsri::registers
+{
+
+/**
+ * @brief Deferred write to a register of the peripheral at `PeripheralBaseAddress`.
+ * The written value is equivalent to REG = (REG & keep_mask) | value.
+ *
+ * @tparam PeripheralBaseAddress Base address of the peripheral that the register belongs to.
+ */
+template<utility::types::register_address_t PeripheralBaseAddress>
+struct register_write
+{
+    /* Base address of the peripheral, made available to users of the write. */
+    static constexpr utility::types::register_address_t peripheral_base_address = PeripheralBaseAddress;
+
+    /* Offset of the register from the peripheral base address. */
+    utility::types::register_address_t address_offset;
+
+    /* Bits of the current register value that are kept. If this is 0, the register does not have to be read. */
+    utility::types::register_value_t keep_mask;
+
+    /* Value that is written to the bits that are not kept. */
+    utility::types::register_value_t value;
+
+    /* Value of the register after the CPU resets. */
+    utility::types::register_value_t value_on_reset;
+
+    /**
+     * @brief Returns the value of the register after applying this write to the register's reset value.
+     *
+     * @return utility::types::register_value_t Register value after the write, if it starts from the reset value.
+     */
+    [[nodiscard]] constexpr auto get_value_from_reset() const noexcept -> utility::types::register_value_t
+    {
+        return (value_on_reset & keep_mask) | value;
+    }
+};
+
+}  // namespace tsri::registers
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../registers/register_base.hpp"
+#include "../registers/register_write.hpp"
 
 namespace tsri::registers
 {
@@ -19,18 +20,22 @@ namespace tsri::registers
  *
  * @tparam PeripheralBaseAddress        Base address of the peripheral.
  * @tparam PeripheralBaseAddressOffset  Offest from theh peripheral base address.
+ * @tparam RegisterSizeInBits           Size of the register in bits: 8, 16, 32 or 64.
  * @tparam ValueOnReset                 Value of the register after the CPU resets.
  * @tparam RegisterFields               Fields inside the register.
  */
 template<
-    utility::types::register_address_t PeripheralBaseAddress,
-    utility::types::register_address_t PeripheralBaseAddressOffset,
-    utility::types::register_value_t   ValueOnReset,
+    utility::types::register_address_t                           PeripheralBaseAddress,
+    utility::types::register_address_t                           PeripheralBaseAddressOffset,
+    utility::types::register_size_t                              RegisterSizeInBits,
+    utility::types::register_value_of_size_t<RegisterSizeInBits> ValueOnReset,
     typename... RegisterFields>
-class register_write_base : register_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterFields...>
+class register_write_base :
+    register_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterSizeInBits, RegisterFields...>
 {
 protected:
-    using base_t = register_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterFields...>;
+    using base_t =
+        register_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, RegisterSizeInBits, RegisterFields...>;
 
 public:
     register_write_base()                                              = delete;
@@ -40,6 +45,15 @@ public:
     auto operator=(const register_write_base&) -> register_write_base& = delete;
     ~register_write_base()                                             = delete;
 
+    /* Memory address of the register, e.g. for use by DMA. */
+    static constexpr utility::types::register_address_t address = base_t::register_address;
+
+    /* Base address of the peripheral that the register belongs to, which selects its backend. */
+    static constexpr utility::types::register_address_t peripheral_base_address = PeripheralBaseAddress;
+
+    /* Size of the register in bits. */
+    static constexpr utility::types::register_size_t size = base_t::register_size;
+
     // NOLINTBEGIN(readability-redundant-inline-specifier)
 
     struct unsafe
@@ -49,9 +63,11 @@ public:
         *
         * @param value
         */
-        TSRI_INLINE static auto set(const utility::types::register_value_t value) noexcept
+        TSRI_INLINE static auto set(const typename base_t::value_t value) noexcept
         {
-            base_t::reference() = value;
+            base_t::template record_usage<register_operation::set>();
+
+            base_t::write(value);
         }
     };
 
@@ -60,7 +76,9 @@ public:
      */
     TSRI_INLINE static auto reset() noexcept
     {
-        base_t::reference() = ValueOnReset;
+        base_t::template record_usage<register_operation::reset>();
+
+        base_t::write(ValueOnReset);
     }
 
     // NOLINTEND(readability-redundant-inline-specifier)
@@ -79,12 +97,51 @@ public:
                   base_t::template are_fields_settable<typename Values::field_t...>)
     TSRI_INLINE static constexpr auto set_fields_overwrite(const Values&... values) noexcept
     {
+        set_fields_overwrite(default_access_t{}, values...);
+    }
+
+    /**
+     * @brief Same as `set_fields_overwrite`, with the given access mode (`inlined` or `out_of_line`), see
+     * `shared_access.hpp`.
+     *
+     * @tparam Values Values to set.
+     */
+    template<access_mode Mode, typename... Values>
+        requires utility::concepts::are_types_unique_v<typename Values::field_t...> and
+                 (base_t::template are_fields_in_register<typename Values::field_t...> and
+                  base_t::template are_fields_settable<typename Values::field_t...>)
+    TSRI_INLINE static constexpr auto set_fields_overwrite(const Mode /* mode */, const Values&... values) noexcept
+    {
+        base_t::template record_usage<register_operation::set_fields_overwrite, typename Values::field_t...>();
+
         /* Reset value needs to be cleared at the field positions. Luckily this can be done at compile-time :) */
         static constexpr auto cleared_reset_value = ~(Values::field_t::bitmask | ...) & ValueOnReset;
 
         const auto field_values = (Values::field_t::get_register_value_from_field_value(values) | ...);
 
-        base_t::reference() = field_values | cleared_reset_value;
+        base_t::template write<Mode>(field_values | cleared_reset_value);
+    }
+
+    /**
+     * @brief Describes a `set_fields_overwrite` with the provided values, without writing to the register.
+     * The returned write can be applied later, for example as an entry of an init table.
+     *
+     * @tparam Values Values to set.
+     * @return register_write<PeripheralBaseAddress> Deferred write that overwrites the register.
+     */
+    template<typename... Values>
+        requires utility::concepts::are_types_unique_v<typename Values::field_t...> and
+                 (base_t::template are_fields_in_register<typename Values::field_t...> and
+                  base_t::template are_fields_settable<typename Values::field_t...>) and
+                 (RegisterSizeInBits == 32U)
+    [[nodiscard]] TSRI_INLINE static constexpr auto defer_set_fields_overwrite(const Values&... values) noexcept
+        -> register_write<PeripheralBaseAddress>
+    {
+        constexpr auto cleared_reset_value = ~(Values::field_t::bitmask | ...) & ValueOnReset;
+
+        const auto field_values = (Values::field_t::get_register_value_from_field_value(values) | ...);
+
+        return { PeripheralBaseAddressOffset, 0U, field_values | cleared_reset_value, ValueOnReset };
     }
 
 #ifdef __thumb__
@@ -109,9 +166,12 @@ public:
     template<typename... Values>
         requires utility::concepts::are_types_unique_v<typename Values::field_t...> and
                  (base_t::template are_fields_in_register<typename Values::field_t...> and
-                  base_t::template are_fields_settable<typename Values::field_t...>)
+                  base_t::template are_fields_settable<typename Values::field_t...>) and
+                 (RegisterSizeInBits == 32U)
     TSRI_INLINE static constexpr auto set_fields_overwrite_size_optimized(const Values&... values) noexcept
     {
+        base_t::template record_usage<register_operation::set_fields_overwrite, typename Values::field_t...>();
+
         /* Maximum value of the immediate offset in the store instruction for the Thumb ISA. */
         static constexpr uint32_t isa_offset_max_value = 124U;
 
@@ -121,12 +181,19 @@ public:
 
         const auto register_value_to_set = field_values | cleared_reset_value;
 
+        /* The store goes straight to the memory address, so other backends (e.g. a trace or a register cache) get a
+         * normal write instead.
+         */
+        if constexpr (not base_t::is_memory_mapped)
+        {
+            base_t::write(register_value_to_set);
+        }
         /* Use a store instruction with immediate offset if the offset fits in the immediate field.
          * Otherwise, use a register as the offset. This is a bit more expensive but can still potentially save some
          * code size.
          */
         // NOLINTNEXTLINE(bugprone-branch-clone): clangd flags this incorrectly.
-        if constexpr (PeripheralBaseAddressOffset <= isa_offset_max_value)
+        else if constexpr (PeripheralBaseAddressOffset <= isa_offset_max_value)
         {
             asm volatile("str %[value], [%[base], %[offset]]"
                          :
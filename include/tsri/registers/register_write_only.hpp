@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include <utility>
+
 #include "../registers/register_write_base.hpp"
 
 namespace tsri::registers
@@ -19,23 +21,34 @@ namespace tsri::registers
  *
  * @tparam PeripheralBaseAddress        Base address of the peripheral.
  * @tparam PeripheralBaseAddressOffset  Offest from theh peripheral base address.
+ * @tparam RegisterSizeInBits           Size of the register in bits: 8, 16, 32 or 64.
  * @tparam ValueOnReset                 Value of the register after the CPU resets.
  * @tparam SupportsAtomicBitOperations  Whether the register supports atomic bit operations (xor, set, clear).
  * @tparam Fields                       Fields inside the register.
  */
 template<
-    utility::types::register_address_t PeripheralBaseAddress,
-    utility::types::register_address_t PeripheralBaseAddressOffset,
-    utility::types::register_value_t   ValueOnReset,
-    bool                               SupportsAtomicBitOperations,
+    utility::types::register_address_t                           PeripheralBaseAddress,
+    utility::types::register_address_t                           PeripheralBaseAddressOffset,
+    utility::types::register_size_t                              RegisterSizeInBits,
+    utility::types::register_value_of_size_t<RegisterSizeInBits> ValueOnReset,
+    bool                                                         SupportsAtomicBitOperations,
     typename... RegisterFields>
 class register_write_only :
-    public register_write_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, ValueOnReset, RegisterFields...>
+    public register_write_base<
+        PeripheralBaseAddress,
+        PeripheralBaseAddressOffset,
+        RegisterSizeInBits,
+        ValueOnReset,
+        RegisterFields...>
 {
 private:
     /* */
-    using base_t =
-        register_write_base<PeripheralBaseAddress, PeripheralBaseAddressOffset, ValueOnReset, RegisterFields...>::base_t;
+    using base_t = register_write_base<
+        PeripheralBaseAddress,
+        PeripheralBaseAddressOffset,
+        RegisterSizeInBits,
+        ValueOnReset,
+        RegisterFields...>::base_t;
 
 public:
     register_write_only()                                              = delete;
@@ -45,13 +58,44 @@ public:
     auto operator=(const register_write_only&) -> register_write_only& = delete;
     ~register_write_only()                                             = delete;
 
+    /**
+     * @brief Set provided fields to the provided values, keeping the other fields at the value they were last written
+     * with. Only available for cached registers (see `backends::cached`): the cache holds the written value, so no read
+     * of the register is needed.
+     *
+     * @tparam Values Values to set. Each value is associated with a field.
+     */
+    template<typename... Values>
+        requires utility::concepts::are_types_unique_v<typename Values::field_t...> and
+                 (base_t::template are_fields_in_register<typename Values::field_t...>) and base_t::is_cached
+    TSRI_INLINE static constexpr auto set_fields(const Values&... values) noexcept
+    {
+        base_t::template record_usage<register_operation::set_fields, typename Values::field_t...>();
+
+        static constexpr auto fields_bitmask = (Values::field_t::bitmask | ...);
+
+        const auto field_values = (Values::field_t::get_register_value_from_field_value(values) | ...);
+
+        base_t::template modify<inlined_t>(fields_bitmask, field_values);
+    }
+
     template<typename... Fields>
         requires utility::concepts::are_types_unique_v<Fields...> and
                  (base_t::template are_fields_in_register<Fields...>)
     /* No need for field check here: all fields are write-only. */
     TSRI_INLINE static constexpr auto set_bits(const Fields&&... fields) noexcept
     {
-        base_t::reference() = (fields.stored_bitmask | ...);
+        set_bits(default_access_t{}, std::move(fields)...);
+    }
+
+    template<access_mode Mode, typename... Fields>
+        requires utility::concepts::are_types_unique_v<Fields...> and
+                 (base_t::template are_fields_in_register<Fields...>)
+    TSRI_INLINE static constexpr auto set_bits(const Mode /* mode */, const Fields&&... fields) noexcept
+    {
+        base_t::template record_usage<register_operation::set_bits, Fields...>();
+
+        base_t::template write<Mode>((fields.stored_bitmask | ...));
     }
 };
 
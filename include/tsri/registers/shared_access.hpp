@@ -0,0 +1,256 @@
+/**
+ * @file shared_access.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Out-of-line register accesses that are shared by all call sites.
+ * @version 0.1
+ * @date 2025-08-09
+ *
+ * By default, every register operation is inlined. That is the fastest, but each call site gets its own address and
+ * mask constants and its own read-modify-write code. When the same operations appear at many call sites, calling a
+ * few shared, non-templated functions is smaller: the call site only loads the arguments into registers.
+ *
+ * The access mode is chosen per call site by passing `registers::out_of_line` (or `registers::inlined`) as the first
+ * argument of a write operation:
+ * @code
+ * PERIPH::CTRL::set_fields(tsri::registers::out_of_line, PERIPH::CTRL::DIV::value{ 4U });
+ * @endcode
+ *
+ * Defining `TSRI_OPTION_OUT_OF_LINE` makes out-of-line the default of the translation unit. The shared functions can
+ * be placed in a RAM section by defining `TSRI_OPTION_SHARED_ACCESS_SECTION`, e.g. as `".time_critical.tsri"`. The
+ * option may differ between translation units: each section gets its own copy of the shared functions.
+ *
+ * The shared functions access absolute addresses through the default backend, so only 32-bit registers of peripherals
+ * that use the default backend go through them. With `TSRI_OPTION_TRACE`, the call site also passes the trace bits of
+ * the register, and the accesses are traced as if they were inlined. Passing `out_of_line` to an operation on any
+ * other register, e.g. of a peripheral with cached registers or another backend, is a compile error. With
+ * `TSRI_OPTION_OUT_OF_LINE`, such registers stay inlined. Writes to the atomic aliases always stay inlined, since they
+ * are a single store anyway.
+ */
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+#include "../backends/backend.hpp"
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+
+namespace tsri::registers
+{
+
+/* Access mode that inlines the register operation at the call site. */
+struct inlined_t
+{};
+
+/* Access mode that calls a shared register access function. */
+struct out_of_line_t
+{};
+
+/* Access mode of the operations that are called without one with `TSRI_OPTION_OUT_OF_LINE`: out-of-line for the
+ * registers that the shared functions can access, inlined for the others. */
+struct default_out_of_line_t
+{};
+
+inline constexpr inlined_t     inlined{};
+inline constexpr out_of_line_t out_of_line{};
+
+/**
+ * @brief Checks if `Mode` is an access mode.
+ */
+template<typename Mode>
+concept access_mode = std::same_as<Mode, inlined_t> or std::same_as<Mode, out_of_line_t> or
+                      std::same_as<Mode, default_out_of_line_t>;
+
+/* Access mode of the operations that are called without one. */
+#ifdef TSRI_OPTION_OUT_OF_LINE
+using default_access_t = default_out_of_line_t;
+#else
+using default_access_t = inlined_t;
+#endif
+
+namespace shared
+{
+
+namespace detail
+{
+
+/**
+ * @brief Returns the FNV-1a hash of the section name `name`, which identifies the section of the shared functions.
+ */
+[[nodiscard]] constexpr auto get_section_id(const char* const name) noexcept -> std::uint32_t
+{
+    std::uint32_t hash = 2166136261U;
+
+    for (const char* character = name; *character != '\0'; character++)
+    {
+        hash = (hash ^ static_cast<std::uint8_t>(*character)) * 16777619U;
+    }
+
+    return hash;
+}
+
+}  // namespace detail
+
+/* Identifies the section of the shared functions of this translation unit, see `functions`. */
+#ifdef TSRI_OPTION_SHARED_ACCESS_SECTION
+constexpr std::uint32_t section_id = detail::get_section_id(TSRI_OPTION_SHARED_ACCESS_SECTION);
+#else
+constexpr std::uint32_t section_id = 0U;
+#endif
+
+/**
+ * @brief Shared register access functions of the translation units whose default backend is `Backend` and whose
+ * shared access section is identified by `SectionId`. Use `functions_t`.
+ *
+ * @tparam Backend Default backend.
+ * @tparam SectionId Identifies the section of the functions, see `section_id`.
+ */
+template<typename Backend, std::uint32_t SectionId>
+class functions;
+
+/**
+ * @brief Shared register access functions of this translation unit, which access absolute addresses through the
+ * default backend.
+ *
+ * The functions are members of an explicit specialization for the default backend and the section of the translation
+ * unit. Translation units with another default backend, or with another `TSRI_OPTION_SHARED_ACCESS_SECTION`, therefore
+ * get their own copy of the functions, instead of sharing one copy that the linker picks from any of them. GCC ignores
+ * the section of implicitly instantiated templates, so the functions can not be members of the primary template.
+ */
+template<>
+class functions<backends::default_backend, section_id>
+{
+private:
+    using backend_t = backends::default_backend;
+
+public:
+    functions()                                    = delete;
+    functions(functions&&)                         = delete;
+    functions(const functions&)                    = delete;
+    auto operator=(functions&&) -> functions&      = delete;
+    auto operator=(const functions&) -> functions& = delete;
+    ~functions()                                   = delete;
+
+    /* Backend of the traced shared functions, whose accesses are recorded with the trace bits of the call site. */
+    using traced_backend_t = backends::traced<backend_t>;
+
+    /**
+     * @brief Writes `value` to the register at `address`.
+     *
+     * @param address Address of the register.
+     * @param value Value to write.
+     */
+    TSRI_NOINLINE TSRI_SHARED_SECTION static void write(
+        const utility::types::register_address_t address, const utility::types::register_value_t value) noexcept
+    {
+        backend_t::write<0U>(address, value);
+    }
+
+    /**
+     * @brief Clears the bits of `clear_mask` in the register at `address` and sets the bits of `set_value`.
+     * Equivalent to REG = (REG & ~clear_mask) | set_value.
+     *
+     * @param address Address of the register.
+     * @param clear_mask Bits to clear.
+     * @param set_value Bits to set.
+     */
+    TSRI_NOINLINE TSRI_SHARED_SECTION static void modify(
+        const utility::types::register_address_t address,
+        const utility::types::register_value_t   clear_mask,
+        const utility::types::register_value_t   set_value) noexcept
+    {
+        backend_t::write<0U>(address, (backend_t::read<0U>(address) & ~clear_mask) | set_value);
+    }
+
+    /**
+     * @brief XORs the bits of `toggle_mask` in the register at `address` and clears the bits of `clear_mask`.
+     * Equivalent to REG = (REG ^ toggle_mask) & ~clear_mask.
+     *
+     * @param address Address of the register.
+     * @param toggle_mask Bits to toggle.
+     * @param clear_mask Bits to clear, e.g. write-clear bits that must not be written back.
+     */
+    TSRI_NOINLINE TSRI_SHARED_SECTION static void toggle(
+        const utility::types::register_address_t address,
+        const utility::types::register_value_t   toggle_mask,
+        const utility::types::register_value_t   clear_mask) noexcept
+    {
+        backend_t::write<0U>(address, (backend_t::read<0U>(address) ^ toggle_mask) & ~clear_mask);
+    }
+
+    /**
+     * @brief Same as `write`, and records the write in the trace, see `traced.hpp`.
+     *
+     * @param address Address of the register.
+     * @param register_tag Trace bits of the register, see `traced::get_register_tag`.
+     * @param value Value to write.
+     */
+    TSRI_NOINLINE TSRI_SHARED_SECTION static void traced_write(const utility::types::register_address_t address,
+                                                               const std::uint64_t                      register_tag,
+                                                               const utility::types::register_value_t value) noexcept
+    {
+        backend_t::write<0U>(address, value);
+
+        traced_backend_t::record_entry(backends::trace_kind::write, register_tag, value);
+    }
+
+    /**
+     * @brief Same as `modify`, and records the read and the write in the trace, see `traced.hpp`.
+     *
+     * @param address Address of the register.
+     * @param register_tag Trace bits of the register, see `traced::get_register_tag`.
+     * @param clear_mask Bits to clear.
+     * @param set_value Bits to set.
+     */
+    TSRI_NOINLINE TSRI_SHARED_SECTION static void traced_modify(
+        const utility::types::register_address_t address,
+        const std::uint64_t                      register_tag,
+        const utility::types::register_value_t   clear_mask,
+        const utility::types::register_value_t   set_value) noexcept
+    {
+        const utility::types::register_value_t value = backend_t::read<0U>(address);
+
+        traced_backend_t::record_entry(backends::trace_kind::read, register_tag, value);
+
+        const utility::types::register_value_t new_value = (value & ~clear_mask) | set_value;
+
+        backend_t::write<0U>(address, new_value);
+
+        traced_backend_t::record_entry(backends::trace_kind::write, register_tag, new_value);
+    }
+
+    /**
+     * @brief Same as `toggle`, and records the read and the write in the trace, see `traced.hpp`.
+     *
+     * @param address Address of the register.
+     * @param register_tag Trace bits of the register, see `traced::get_register_tag`.
+     * @param toggle_mask Bits to toggle.
+     * @param clear_mask Bits to clear, e.g. write-clear bits that must not be written back.
+     */
+    TSRI_NOINLINE TSRI_SHARED_SECTION static void traced_toggle(
+        const utility::types::register_address_t address,
+        const std::uint64_t                      register_tag,
+        const utility::types::register_value_t   toggle_mask,
+        const utility::types::register_value_t   clear_mask) noexcept
+    {
+        const utility::types::register_value_t value = backend_t::read<0U>(address);
+
+        traced_backend_t::record_entry(backends::trace_kind::read, register_tag, value);
+
+        const utility::types::register_value_t new_value = (value ^ toggle_mask) & ~clear_mask;
+
+        backend_t::write<0U>(address, new_value);
+
+        traced_backend_t::record_entry(backends::trace_kind::write, register_tag, new_value);
+    }
+};
+
+/* Shared functions of this translation unit. */
+using functions_t = functions<backends::default_backend, section_id>;
+
+/* Backend of the traced shared functions of this translation unit. */
+using traced_backend_t = functions_t::traced_backend_t;
+
+}  // namespace shared
+
+}  // namespace tsri::registers
@@ -0,0 +1,111 @@
+/**
+ * @file usage_manifest.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Link-time manifest of the register operations in a firmware image.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Defining `TSRI_OPTION_MANIFEST` makes every register operation emit a record into the `.tsri_manifest` section of the
+ * object file. The section is not allocated: it is kept in the ELF file, like debug information, but it takes no flash
+ * or RAM and adds no instructions. Without the option, no records are emitted.
+ *
+ * Register operations are always inlined, so there is one record per call site. A record is 32 bytes, in the byte
+ * order of the target:
+ * - 4 bytes each: low and high word of the register address, low and high word of the bitmask of the fields that are
+ *   touched, the `register_operation`, and the register size in bits;
+ * - the address of the call site (4 or 8 bytes), padded to 8 bytes.
+ *
+ * Records of functions that the linker removes (`--gc-sections`) are removed with them. With
+ * `TSRI_OPTION_DISABLE_ALWAYS_INLINE`, the records are per instantiation instead of per call site.
+ *
+ * `codegen/manifest.py` reads the records from the final ELF file and reports which peripherals, registers and fields
+ * the image uses, how many call sites each has and which functions contain them.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+
+namespace tsri::registers
+{
+
+/**
+ * @brief Register operation in the usage manifest.
+ */
+enum class register_operation : std::uint32_t
+{
+    /* `get`. */
+    get,
+    /* `get_fields`. */
+    get_fields,
+    /* `is_any_bit_set`, `are_all_bits_set`. */
+    test_bits,
+    /* `wait_until...` and the `until...` conditions of async tasks. */
+    wait,
+    /* `dispatch`. */
+    dispatch,
+    /* `read_and_acknowledge`, `dispatch_and_acknowledge`. */
+    acknowledge,
+    /* `set`. */
+    set,
+    /* `reset`. */
+    reset,
+    /* `set_fields`. */
+    set_fields,
+    /* `set_fields_overwrite`, `set_fields_overwrite_size_optimized`. */
+    set_fields_overwrite,
+    /* `clear_fields`. */
+    clear_fields,
+    /* `set_bits`, `set_bit`. */
+    set_bits,
+    /* `clear_bits`, `clear_bit`. */
+    clear_bits,
+    /* `toggle_bits`, `toggle_bit`. */
+    toggle_bits,
+    /* `sample_into`. */
+    sample
+};
+
+/**
+ * @brief Emits the manifest record of a register operation at the call site, if `TSRI_OPTION_MANIFEST` is defined.
+ * Emits no instructions, and nothing during constant evaluation.
+ *
+ * @tparam Address Address of the register.
+ * @tparam SizeInBits Size of the register in bits.
+ * @tparam FieldsBitmask Bits of the fields that the operation touches.
+ * @tparam Operation Register operation.
+ */
+template<
+    utility::types::register_address_t Address,
+    utility::types::register_size_t    SizeInBits,
+    std::uint64_t                      FieldsBitmask,
+    register_operation                 Operation>
+TSRI_INLINE constexpr void record_usage() noexcept
+{
+#ifdef TSRI_OPTION_MANIFEST
+    if !consteval
+    {
+        /* The label marks the call site. The record is linked to the code section of the call site ("o" flag), so the
+         * linker removes it together with unused functions, and keeps it otherwise.
+         */
+        asm volatile(".Ltsri_manifest_%=:\n"
+                     ".pushsection .tsri_manifest, \"o\", %%progbits, .Ltsri_manifest_%=\n"
+                     ".balign 8\n"
+                     ".4byte %c0, %c1, %c2, %c3, %c4, %c5\n"
+                     ".dc.a .Ltsri_manifest_%=\n"
+                     ".balign 8\n"
+                     ".popsection"
+                     :
+                     : "i"(static_cast<std::uint32_t>(Address)),
+                       "i"(static_cast<std::uint32_t>(static_cast<std::uint64_t>(Address) >> 32U)),
+                       "i"(static_cast<std::uint32_t>(FieldsBitmask)),
+                       "i"(static_cast<std::uint32_t>(FieldsBitmask >> 32U)),
+                       "i"(static_cast<std::uint32_t>(Operation)),
+                       "i"(static_cast<std::uint32_t>(SizeInBits)));
+    }
+#endif
+}
+
+}  // namespace tsri::registers
@@ -0,0 +1,330 @@
+/**
+ * @file fifo.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Streaming data through FIFO data registers.
+ * @version 0.1
+ * @date 2025-08-06
+ *
+ * Writing a buffer to a FIFO one entry at a time, polling the status register before each entry, costs one status read
+ * per entry. The `fifo` class reads the status register once, computes how many entries fit (or are available), and
+ * transfers that many entries in one burst.
+ *
+ * The registers and status fields of a FIFO are described by a descriptor:
+ * @code
+ * struct uart0_fifo
+ * {
+ *     using element_t       = std::uint8_t;
+ *     using data_register   = UART0::UARTDR;
+ *     using data_field      = UART0::UARTDR::DATA;
+ *     using status_register = UART0::UARTFR;
+ *
+ *     static constexpr std::size_t depth = 32U;
+ *
+ *     using tx_full_field  = UART0::UARTFR::TXFF;
+ *     using tx_empty_field = UART0::UARTFR::TXFE;
+ *     using rx_full_field  = UART0::UARTFR::RXFF;
+ *     using rx_empty_field = UART0::UARTFR::RXFE;
+ * };
+ *
+ * tsri::streams::fifo<uart0_fifo>::write(buffer);
+ * @endcode
+ *
+ * The transmit side needs either a `tx_level_field` (number of entries in the FIFO), or a `tx_full_field` and
+ * optionally a `tx_empty_field`. The receive side needs either an `rx_level_field`, or an `rx_empty_field` and
+ * optionally an `rx_full_field`. With only flags, a burst is one entry, or the full depth when the FIFO is empty
+ * (transmit) or full (receive). Flags that are active-low, such as "not full", are wrapped in `streams::inverted`.
+ */
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+#include "../polling/polling.hpp"
+#include "../utility/inline_macro.hpp"
+#include "../utility/types.hpp"
+
+namespace tsri::streams
+{
+
+/**
+ * @brief Marks a status flag as active-low, e.g. `inverted<SSPSR::TNF>` as the full flag of a "transmit not full" bit.
+ *
+ * @tparam Field Status field.
+ */
+template<typename Field>
+struct inverted
+{};
+
+namespace detail
+{
+
+/* Field of a status flag, with or without `inverted`. */
+template<typename Flag>
+struct flag_traits
+{
+    using field_t = Flag;
+
+    static constexpr bool is_inverted = false;
+};
+
+template<typename Field>
+struct flag_traits<inverted<Field>>
+{
+    using field_t = Field;
+
+    static constexpr bool is_inverted = true;
+};
+
+template<typename Flag>
+using flag_field_t = typename flag_traits<Flag>::field_t;
+
+}  // namespace detail
+
+/**
+ * @brief Checks if `Descriptor` describes the registers of a FIFO.
+ */
+template<typename Descriptor>
+concept descriptor = std::unsigned_integral<typename Descriptor::element_t> and
+                     (sizeof(typename Descriptor::element_t) <= sizeof(utility::types::register_value_t)) and
+                     requires {
+                         typename Descriptor::data_register;
+                         typename Descriptor::data_field;
+                         typename Descriptor::status_register;
+                         { Descriptor::depth } -> std::convertible_to<std::size_t>;
+                     };
+
+/**
+ * @brief Transfers data through the FIFO described by `Descriptor`.
+ *
+ * @tparam Descriptor FIFO descriptor.
+ */
+template<descriptor Descriptor>
+class fifo
+{
+private:
+    /* Field of the data register that holds a FIFO entry. */
+    using data_field_t = typename Descriptor::data_field;
+
+    /* Whether the transmit side has a level field or a full flag. */
+    static constexpr bool has_tx_status =
+        requires { typename Descriptor::tx_level_field; } or requires { typename Descriptor::tx_full_field; };
+
+    /* Whether the receive side has a level field or an empty flag. */
+    static constexpr bool has_rx_status =
+        requires { typename Descriptor::rx_level_field; } or requires { typename Descriptor::rx_empty_field; };
+
+public:
+    fifo()                               = delete;
+    fifo(fifo&&)                         = delete;
+    fifo(const fifo&)                    = delete;
+    auto operator=(fifo&&) -> fifo&      = delete;
+    auto operator=(const fifo&) -> fifo& = delete;
+    ~fifo()                              = delete;
+
+    /* Type of a FIFO entry. */
+    using element_t = typename Descriptor::element_t;
+
+    /**
+     * @brief Writes as many entries as currently fit in the FIFO, using one status read.
+     *
+     * @param data Entries to write.
+     * @return std::size_t Number of entries that were written.
+     */
+    [[nodiscard]] TSRI_INLINE static auto try_write(const std::span<const element_t> data) noexcept -> std::size_t
+        requires has_tx_status
+    {
+        const std::size_t count = std::min(get_tx_room(), data.size());
+
+        for (std::size_t index = 0U; index < count; index++)
+        {
+            Descriptor::data_register::set_fields_overwrite(typename data_field_t::value{ data[index] });
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Reads as many entries as are currently available in the FIFO, using one status read.
+     *
+     * @param data Buffer for the entries.
+     * @return std::size_t Number of entries that were read.
+     */
+    [[nodiscard]] TSRI_INLINE static auto try_read(const std::span<element_t> data) noexcept -> std::size_t
+        requires has_rx_status
+    {
+        const std::size_t count = std::min(get_rx_available(), data.size());
+
+        for (std::size_t index = 0U; index < count; index++)
+        {
+            data[index] = static_cast<element_t>(get_field_value<data_field_t>(
+                Descriptor::data_register::template get_fields<data_field_t>()));
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Writes all entries in bursts, or until the polling policy gives up while the FIFO is full.
+     *
+     * @param data Entries to write.
+     * @param policy Polling policy, decides on the timeout and backoff.
+     * @return std::size_t Number of entries that were written.
+     */
+    template<polling::policy Policy = polling::spin<>>
+        requires has_tx_status
+    TSRI_INLINE static auto write(const std::span<const element_t> data, Policy policy = {}) noexcept -> std::size_t
+    {
+        return transfer(data, policy, [](const auto remaining) { return try_write(remaining); });
+    }
+
+    /**
+     * @brief Fills the buffer in bursts, or until the polling policy gives up while the FIFO is empty.
+     *
+     * @param data Buffer for the entries.
+     * @param policy Polling policy, decides on the timeout and backoff.
+     * @return std::size_t Number of entries that were read.
+     */
+    template<polling::policy Policy = polling::spin<>>
+        requires has_rx_status
+    TSRI_INLINE static auto read(const std::span<element_t> data, Policy policy = {}) noexcept -> std::size_t
+    {
+        return transfer(data, policy, [](const auto remaining) { return try_read(remaining); });
+    }
+
+private:
+    /**
+     * @brief Returns the value of `Field` from the result of `get_fields`.
+     */
+    template<typename Field>
+    TSRI_INLINE static constexpr auto get_field_value(const auto& fields) noexcept -> utility::types::register_value_t
+    {
+        if constexpr (requires { fields.template get<Field>(); })
+        {
+            return fields.template get<Field>();
+        }
+        else
+        {
+            return fields.get();
+        }
+    }
+
+    /**
+     * @brief Checks if the status flag `Flag` is active in the result of `get_fields`.
+     */
+    template<typename Flag>
+    TSRI_INLINE static constexpr auto is_flag_active(const auto& fields) noexcept -> bool
+    {
+        return (get_field_value<detail::flag_field_t<Flag>>(fields) != 0U) != detail::flag_traits<Flag>::is_inverted;
+    }
+
+    /**
+     * @brief Reads the status register once and returns the number of entries that fit in the transmit FIFO.
+     */
+    TSRI_INLINE static auto get_tx_room() noexcept -> std::size_t
+    {
+        using status_register_t = typename Descriptor::status_register;
+
+        if constexpr (requires { typename Descriptor::tx_level_field; })
+        {
+            using level_field_t = typename Descriptor::tx_level_field;
+
+            const auto fields = status_register_t::template get_fields<level_field_t>();
+
+            return Descriptor::depth - get_field_value<level_field_t>(fields);
+        }
+        else if constexpr (requires { typename Descriptor::tx_empty_field; })
+        {
+            using full_t  = typename Descriptor::tx_full_field;
+            using empty_t = typename Descriptor::tx_empty_field;
+
+            const auto fields = status_register_t::template get_fields<
+                detail::flag_field_t<full_t>,
+                detail::flag_field_t<empty_t>>();
+
+            if (is_flag_active<empty_t>(fields))
+            {
+                return Descriptor::depth;
+            }
+
+            return is_flag_active<full_t>(fields) ? 0U : 1U;
+        }
+        else
+        {
+            using full_t = typename Descriptor::tx_full_field;
+
+            return is_flag_active<full_t>(status_register_t::template get_fields<detail::flag_field_t<full_t>>()) ? 0U
+                                                                                                                   : 1U;
+        }
+    }
+
+    /**
+     * @brief Reads the status register once and returns the number of entries available in the receive FIFO.
+     */
+    TSRI_INLINE static auto get_rx_available() noexcept -> std::size_t
+    {
+        using status_register_t = typename Descriptor::status_register;
+
+        if constexpr (requires { typename Descriptor::rx_level_field; })
+        {
+            using level_field_t = typename Descriptor::rx_level_field;
+
+            return get_field_value<level_field_t>(status_register_t::template get_fields<level_field_t>());
+        }
+        else if constexpr (requires { typename Descriptor::rx_full_field; })
+        {
+            using full_t  = typename Descriptor::rx_full_field;
+            using empty_t = typename Descriptor::rx_empty_field;
+
+            const auto fields = status_register_t::template get_fields<
+                detail::flag_field_t<full_t>,
+                detail::flag_field_t<empty_t>>();
+
+            if (is_flag_active<full_t>(fields))
+            {
+                return Descriptor::depth;
+            }
+
+            return is_flag_active<empty_t>(fields) ? 0U : 1U;
+        }
+        else
+        {
+            using empty_t = typename Descriptor::rx_empty_field;
+
+            return is_flag_active<empty_t>(status_register_t::template get_fields<detail::flag_field_t<empty_t>>())
+                       ? 0U
+                       : 1U;
+        }
+    }
+
+    /**
+     * @brief Calls `burst` with the remaining entries until all entries are transferred, or until the policy gives up.
+     *
+     * @param data All entries.
+     * @param policy Polling policy, asked after every burst that transferred nothing.
+     * @param burst Transfers a burst of the remaining entries and returns the number of transferred entries.
+     * @return std::size_t Number of entries that were transferred.
+     */
+    TSRI_INLINE static auto transfer(const auto data, polling::policy auto& policy, const auto& burst) noexcept
+        -> std::size_t
+    {
+        std::size_t transferred = 0U;
+
+        while (transferred < data.size())
+        {
+            const std::size_t count = burst(data.subspan(transferred));
+
+            transferred += count;
+
+            if (count == 0U and !policy.keep_waiting())
+            {
+                break;
+            }
+        }
+
+        return transferred;
+    }
+};
+
+}  // namespace tsri::streams
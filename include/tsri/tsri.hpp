@@ -1,6 +1,10 @@
 #pragma once
 
 #include "fields/field.hpp"
+#include "init/init_table.hpp"
+#include "peripherals/peripheral.hpp"
+#include "peripherals/retained_registers.hpp"
 #include "registers/register_read_only.hpp"
 #include "registers/register_write_only.hpp"
 #include "registers/register_read_write.hpp"
+#include "registers/register_composite.hpp"
@@ -0,0 +1,136 @@
+/**
+ * @file bits.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Bit scanning and single-bit manipulation functions.
+ * @version 0.1
+ * @date 2025-08-06
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "inline_macro.hpp"
+#include "types.hpp"
+
+namespace tsri::utility::bits
+{
+
+namespace detail
+{
+
+/* Position of the lowest set bit of each nibble. Entry 0 is never used. */
+inline constexpr std::array<std::uint8_t, 16U> lowest_set_bit_in_nibble{ 0U, 0U, 1U, 0U, 2U, 0U, 1U, 0U,
+                                                                         3U, 0U, 1U, 0U, 2U, 0U, 1U, 0U };
+
+}  // namespace detail
+
+/**
+ * @brief Returns the position of the lowest set bit of `value`, which must not be 0.
+ *
+ * Cores without a CLZ instruction (ARMv6-M, e.g. the Cortex-M0+) would call a library function for
+ * `std::countr_zero`. On those cores, the value is scanned per nibble instead and the position inside the first
+ * non-zero nibble is looked up in a 16-byte table.
+ *
+ * @param value Value with at least one bit set.
+ * @return types::register_size_t Position of the lowest set bit.
+ */
+[[nodiscard]] TSRI_INLINE constexpr auto get_lowest_set_bit(types::register_value_t value) noexcept
+    -> types::register_size_t
+{
+#if defined(__ARM_ARCH) and !defined(__ARM_FEATURE_CLZ)
+    constexpr types::register_value_t nibble_mask = 0xFU;
+    constexpr types::register_size_t  nibble_size = 4U;
+
+    types::register_size_t position = 0U;
+
+    while ((value & nibble_mask) == 0U)
+    {
+        value >>= nibble_size;
+        position += nibble_size;
+    }
+
+    return position + detail::lowest_set_bit_in_nibble[value & nibble_mask];
+#else
+    return static_cast<types::register_size_t>(std::countr_zero(value));
+#endif
+}
+
+/**
+ * @brief Returns `value` with the bit at `position` set.
+ *
+ * Written as a plain shift and OR, so the compiler can fold it into the surrounding code. On RV32 cores with the Zbs
+ * extension (e.g. the Hazard3 cores of the RP2350), compilers emit one `bset` for a position that is only known at
+ * runtime, and `bseti` for a constant one. `tests/zbs_size_check.cpp` checks this.
+ *
+ * @param value Value to modify.
+ * @param position Position of the bit, must be smaller than 32.
+ * @return types::register_value_t Value with the bit set.
+ */
+[[nodiscard]] TSRI_INLINE constexpr auto set_bit(
+    const types::register_value_t value, const types::register_size_t position) noexcept -> types::register_value_t
+{
+    return value | (types::register_value_t{ 1U } << position);
+}
+
+/**
+ * @brief Returns `value` with the bit at `position` cleared. Compiles to `bclr` on RV32 with Zbs, see `set_bit`.
+ *
+ * @param value Value to modify.
+ * @param position Position of the bit, must be smaller than 32.
+ * @return types::register_value_t Value with the bit cleared.
+ */
+[[nodiscard]] TSRI_INLINE constexpr auto clear_bit(
+    const types::register_value_t value, const types::register_size_t position) noexcept -> types::register_value_t
+{
+    return value & ~(types::register_value_t{ 1U } << position);
+}
+
+/**
+ * @brief Returns `value` with the bit at `position` inverted. Compiles to `binv` on RV32 with Zbs, see `set_bit`.
+ *
+ * @param value Value to modify.
+ * @param position Position of the bit, must be smaller than 32.
+ * @return types::register_value_t Value with the bit inverted.
+ */
+[[nodiscard]] TSRI_INLINE constexpr auto invert_bit(
+    const types::register_value_t value, const types::register_size_t position) noexcept -> types::register_value_t
+{
+    return value ^ (types::register_value_t{ 1U } << position);
+}
+
+/**
+ * @brief Returns the bit of `value` at `position`, as 0 or 1. Compiles to `bext` on RV32 with Zbs, see `set_bit`.
+ * With a constant position, the shift-then-mask form lets the compiler emit `bexti`, or a shift and a small mask on
+ * other cores, instead of a wide mask that has to be loaded.
+ *
+ * @param value Value to read the bit from.
+ * @param position Position of the bit, must be smaller than 32.
+ * @return types::register_value_t Value of the bit.
+ */
+[[nodiscard]] TSRI_INLINE constexpr auto extract_bit(
+    const types::register_value_t value, const types::register_size_t position) noexcept -> types::register_value_t
+{
+    return (value >> position) & 1U;
+}
+
+/**
+ * @brief Calls `function` with the position of each set bit of `value`, from the lowest to the highest bit.
+ * The number of iterations equals the number of set bits.
+ *
+ * @param value Value to scan.
+ * @param function Function that takes a bit position.
+ */
+TSRI_INLINE constexpr void for_each_set_bit(types::register_value_t value, const auto& function) noexcept
+{
+    while (value != 0U)
+    {
+        function(get_lowest_set_bit(value));
+
+        /* Clear the lowest set bit. */
+        value &= value - 1U;
+    }
+}
+
+}  // namespace tsri::utility::bits
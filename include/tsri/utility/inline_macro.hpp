@@ -5,3 +5,13 @@
 #else
 #define TSRI_INLINE [[gnu::always_inline]]
 #endif
+
+/* Used for functions that are shared between all call sites, such as the init table interpreter. */
+#define TSRI_NOINLINE [[gnu::noinline]]
+
+/* Section of the shared register access functions, e.g. `.time_critical.tsri` to run them from RAM on XIP targets. */
+#ifdef TSRI_OPTION_SHARED_ACCESS_SECTION
+#define TSRI_SHARED_SECTION [[gnu::section(TSRI_OPTION_SHARED_ACCESS_SECTION)]]
+#else
+#define TSRI_SHARED_SECTION
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <type_traits>
 
 namespace tsri::utility::types
 {
@@ -27,4 +28,27 @@ using register_ptr_t = volatile register_value_t* const;
  */
 using register_size_t = uint32_t;
 
+/**
+ * @brief Unsigned type of exactly `SizeInBits` bits, used to access a register with its native width.
+ * Narrow peripherals may fault on, or ignore parts of, wider accesses.
+ *
+ * @tparam SizeInBits Size of the register in bits: 8, 16, 32 or 64.
+ */
+template<register_size_t SizeInBits>
+    requires (SizeInBits == 8U or SizeInBits == 16U or SizeInBits == 32U or SizeInBits == 64U)
+using register_access_t = std::conditional_t<
+    SizeInBits == 8U,
+    uint8_t,
+    std::conditional_t<SizeInBits == 16U, uint16_t, std::conditional_t<SizeInBits == 32U, uint32_t, uint64_t>>>;
+
+/**
+ * @brief Type for the values and masks of a register of `SizeInBits` bits.
+ * Registers up to 32 bits use `register_value_t`, because that is the width the CPU computes in anyway: narrower types
+ * would only add zero-extensions. 64-bit registers use a 64-bit type.
+ *
+ * @tparam SizeInBits Size of the register in bits.
+ */
+template<register_size_t SizeInBits>
+using register_value_of_size_t = std::conditional_t<(SizeInBits > 32U), uint64_t, register_value_t>;
+
 }  // namespace tsri::utility::types
@@ -0,0 +1,121 @@
+/**
+ * @file bulk_decoder_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the bulk decoder against a scalar reference.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Built once with the default flags (SSE2 on x86-64) and, where the compiler supports it, once more with `-mavx2`.
+ * The capture has 8k+5 values, so with AVX2 the last five values go through the SSE2 loop and the scalar loop, and
+ * with SSE2 the last one goes through the scalar loop.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "test.hpp"
+#include "tsri/fields/bulk_decoder.hpp"
+
+using namespace test;
+
+namespace
+{
+
+/* Fields of a 32-bit status register: all bits, the top nibble, the top bit and a field in the middle. */
+using full_t = tsri::fields::field<0U, 32U, tsri::fields::field_types::read_only, 0, 0x40000000U>;
+using high_t = tsri::fields::field<28U, 4U, tsri::fields::field_types::read_only, 0, 0x40000000U>;
+using top_t  = tsri::fields::field<31U, 1U, tsri::fields::field_types::read_only, 0, 0x40000000U>;
+using mid_t  = tsri::fields::field<9U, 7U, tsri::fields::field_types::read_only, 0, 0x40000000U>;
+
+/* Number of values in the capture. */
+constexpr std::size_t CAPTURE_SIZE = 8U * 1024U + 5U;
+
+/**
+ * @brief Decodes one field the way it is documented, without the masks of the field definition.
+ */
+constexpr auto reference(const std::uint32_t value, const unsigned start, const unsigned length) -> std::uint32_t
+{
+    const std::uint32_t mask = length == 32U ? ~std::uint32_t{ 0U } : (std::uint32_t{ 1U } << length) - 1U;
+
+    return (value >> start) & mask;
+}
+
+/**
+ * @brief Returns a capture of pseudo-random values, such that every bit of every field changes.
+ */
+auto make_capture() -> std::vector<std::uint32_t>
+{
+    std::vector<std::uint32_t> capture(CAPTURE_SIZE);
+    std::uint32_t              state = 0x12345678U;
+
+    for (auto& value : capture)
+    {
+        state ^= state << 13U;
+        state ^= state >> 17U;
+        state ^= state << 5U;
+        value = state;
+    }
+
+    return capture;
+}
+
+void test_decode_matches_reference()
+{
+    const auto capture = make_capture();
+
+    std::vector<std::uint32_t> full(CAPTURE_SIZE);
+    std::vector<std::uint32_t> high(CAPTURE_SIZE);
+    std::vector<std::uint32_t> top(CAPTURE_SIZE);
+    std::vector<std::uint32_t> mid(CAPTURE_SIZE);
+
+    check(tsri::fields::bulk_decoder<full_t, high_t, top_t, mid_t>::decode(capture, full, high, top, mid) ==
+          CAPTURE_SIZE);
+
+    std::size_t mismatches = 0U;
+
+    for (std::size_t index = 0U; index < CAPTURE_SIZE; index++)
+    {
+        const auto value = capture[index];
+
+        if (full[index] != reference(value, 0U, 32U) or high[index] != reference(value, 28U, 4U) or
+            top[index] != reference(value, 31U, 1U) or mid[index] != reference(value, 9U, 7U))
+        {
+            mismatches++;
+        }
+    }
+
+    check(mismatches == 0U);
+}
+
+void test_decode_stops_at_the_smallest_buffer()
+{
+    const auto capture = make_capture();
+
+    /* One value less than the capture, and a sentinel behind it that must not be written. */
+    constexpr std::uint32_t    SENTINEL = 0xA5A5A5A5U;
+    std::vector<std::uint32_t> high(CAPTURE_SIZE, SENTINEL);
+
+    check(tsri::fields::bulk_decoder<high_t>::decode(capture, std::span{ high }.first(CAPTURE_SIZE - 1U)) ==
+          CAPTURE_SIZE - 1U);
+    check(high[CAPTURE_SIZE - 2U] == reference(capture[CAPTURE_SIZE - 2U], 28U, 4U));
+    check(high[CAPTURE_SIZE - 1U] == SENTINEL);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+#if defined(__AVX2__)
+    /* The AVX2 build can only run on a CPU with AVX2; CTest reports it as skipped otherwise. */
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        return 77;
+    }
+#endif
+
+    test_decode_matches_reference();
+    test_decode_stops_at_the_smallest_buffer();
+
+    return result();
+}
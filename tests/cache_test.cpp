@@ -0,0 +1,191 @@
+/**
+ * @file cache_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the write-back register cache on a `loopback_bus`.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * The device has two adjacent 32-bit configuration registers and a write-only mode register, all cached with the
+ * `write_back` policy, and an identification register that is not cached. The loopback bus counts the transactions, so
+ * the test can check which accesses reach the bus and that `sync()` writes adjacent dirty registers in one burst.
+ */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "tsri/backends/backend.hpp"
+
+/* Base address that identifies the device. */
+constexpr tsri::utility::types::register_address_t DEVICE_BASE_ADDRESS = 0x1000U;
+
+using bus_t = tsri::backends::loopback_bus<64U>;
+
+template<>
+struct tsri::backends::peripheral_backend<DEVICE_BASE_ADDRESS>
+{
+    using type = tsri::backends::transport<bus_t>;
+};
+
+template<>
+struct tsri::backends::register_cache_map<DEVICE_BASE_ADDRESS>
+{
+    static constexpr cache_policy policy = cache_policy::write_back;
+
+    static constexpr std::array<cached_register, 3U> registers{ {
+        { 0x10U, 32U, 0x0U, true },
+        { 0x14U, 32U, 0x0U, true },
+        { 0x20U, 32U, 0xF0U, false },
+    } };
+};
+
+#include "tsri/tsri.hpp"
+#include "test.hpp"
+
+using namespace test;
+
+namespace
+{
+
+class DEVICE : public tsri::peripherals::peripheral<DEVICE_BASE_ADDRESS>
+{
+private:
+    using id_id_base_t     = tsri::fields::field<0U, 8U, tsri::fields::field_types::read_only, 0, 0x1000U, 8U>;
+    using cfg_rate_base_t  = tsri::fields::field<0U, 8U, tsri::fields::field_types::read_write, 0, 0x1010U>;
+    using cfg_gain_base_t  = tsri::fields::field<8U, 8U, tsri::fields::field_types::read_write, 0, 0x1010U>;
+    using thr_thr_base_t   = tsri::fields::field<0U, 8U, tsri::fields::field_types::read_write, 0, 0x1014U>;
+    using mode_low_base_t  = tsri::fields::field<0U, 4U, tsri::fields::field_types::write_only, 0, 0x1020U>;
+    using mode_high_base_t = tsri::fields::field<4U, 4U, tsri::fields::field_types::write_only, 0xF, 0x1020U>;
+
+public:
+    struct ID : public tsri::registers::register_read_only<DEVICE_BASE_ADDRESS, 0x0U, 8U, id_id_base_t>
+    {};
+
+    struct CFG :
+        public tsri::registers::register_read_write<DEVICE_BASE_ADDRESS, 0x10U, 32U, 0U, false, cfg_rate_base_t,
+                                                    cfg_gain_base_t>
+    {
+        struct RATE : public cfg_rate_base_t
+        {
+            using value = cfg_rate_base_t::value;
+        };
+
+        struct GAIN : public cfg_gain_base_t
+        {
+            using value = cfg_gain_base_t::value;
+        };
+    };
+
+    struct THR : public tsri::registers::register_read_write<DEVICE_BASE_ADDRESS, 0x14U, 32U, 0U, false, thr_thr_base_t>
+    {
+        struct THR_ : public thr_thr_base_t
+        {
+            using value = thr_thr_base_t::value;
+        };
+    };
+
+    struct MODE :
+        public tsri::registers::register_write_only<DEVICE_BASE_ADDRESS, 0x20U, 32U, 0xF0U, false, mode_low_base_t,
+                                                    mode_high_base_t>
+    {
+        struct LOW : public mode_low_base_t
+        {
+            using value = mode_low_base_t::value;
+        };
+    };
+
+    DEVICE() = delete;
+};
+
+/**
+ * @brief Resets the transaction counters of `bus`.
+ */
+void reset_counts(bus_t& bus)
+{
+    bus.reads  = 0U;
+    bus.writes = 0U;
+}
+
+void test_writes_only_change_the_cache(bus_t& bus)
+{
+    reset_counts(bus);
+
+    DEVICE::CFG::set_fields(DEVICE::CFG::RATE::value{ 5U }, DEVICE::CFG::GAIN::value{ 6U });
+    DEVICE::THR::set_fields(DEVICE::THR::THR_::value{ 9U });
+    DEVICE::MODE::set_fields(DEVICE::MODE::LOW::value{ 3U });
+
+    /* CFG and THR are read once to fill the cache. MODE is write-only and starts at its reset value. */
+    check(bus.reads == 2U and bus.writes == 0U);
+    check(bus.memory[0x12U] == std::byte{ 0U } and bus.memory[0x13U] == std::byte{ 0U });
+}
+
+void test_reads_are_served_from_the_cache(bus_t& bus)
+{
+    reset_counts(bus);
+
+    check(DEVICE::CFG::get() == 0x605U);
+    check(DEVICE::THR::get() == 0x9U);
+    check(bus.reads == 0U);
+
+    /* Registers that are not cached are read from the bus. */
+    bus.memory[0x0U] = std::byte{ 0x68U };
+
+    check(DEVICE::ID::get() == 0x68U);
+    check(bus.reads == 1U);
+}
+
+void test_sync_coalesces_adjacent_registers(bus_t& bus)
+{
+    reset_counts(bus);
+
+    DEVICE::sync();
+
+    /* CFG and THR are written in one burst. MODE is not adjacent to THR and is written on its own. */
+    check(bus.reads == 0U and bus.writes == 2U);
+    check(bus.memory[0x12U] == std::byte{ 0x06U } and bus.memory[0x13U] == std::byte{ 0x05U });
+    check(bus.memory[0x17U] == std::byte{ 0x09U });
+    check(bus.memory[0x23U] == std::byte{ 0xF3U });
+
+    /* Nothing is dirty after the sync. */
+    DEVICE::sync();
+
+    check(bus.writes == 2U);
+}
+
+void test_unchanged_writes_are_left_out(bus_t& bus)
+{
+    reset_counts(bus);
+
+    DEVICE::CFG::set_fields(DEVICE::CFG::RATE::value{ 5U });
+    DEVICE::sync();
+
+    check(bus.reads == 0U and bus.writes == 0U);
+}
+
+void test_invalidate_drops_the_cached_values(bus_t& bus)
+{
+    DEVICE::THR::set_fields(DEVICE::THR::THR_::value{ 1U });
+    DEVICE::invalidate();
+    reset_counts(bus);
+
+    /* The write to THR was not synced, and the cached values are read again. */
+    check(DEVICE::THR::get() == 0x9U);
+    check(DEVICE::CFG::get() == 0x605U);
+    check(bus.reads == 2U and bus.writes == 0U);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    bus_t bus;
+
+    tsri::backends::transport<bus_t>::attach<DEVICE_BASE_ADDRESS>(bus);
+
+    test_writes_only_change_the_cache(bus);
+    test_reads_are_served_from_the_cache(bus);
+    test_sync_coalesces_adjacent_registers(bus);
+    test_unchanged_writes_are_left_out(bus);
+    test_invalidate_drops_the_cached_values(bus);
+
+    return result();
+}
@@ -0,0 +1,255 @@
+/**
+ * @file cosim_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the co-simulation backend with a device model in another thread.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * The driver and the model open the same `memfd`, each with its own mapping, like two processes would. `INTR` (which
+ * has write-clear bits) and `DATA` (a FIFO) are in the side-effect map, so their accesses go through the doorbell;
+ * `CTRL` and `STATUS` are plain registers in the shared register file.
+ */
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "tsri/backends/backend.hpp"
+#include "tsri/backends/cosim.hpp"
+
+template<>
+struct tsri::backends::peripheral_backend<0x40000000U>
+{
+    using type = tsri::backends::cosim;
+};
+
+template<>
+struct tsri::backends::side_effect_map<0x40000000U>
+{
+    static constexpr std::array<tsri::utility::types::register_address_t, 2U> offsets{ { 0x8U, 0xCU } };
+};
+
+#include "test.hpp"
+#include "test_peripheral.hpp"
+
+using tsri::backends::cosim;
+using tsri::backends::cosim_access;
+using tsri::backends::cosim_channel;
+using tsri::backends::cosim_header;
+using tsri::backends::cosim_request;
+using namespace test;
+
+namespace
+{
+
+/* Size of the register file. */
+constexpr std::size_t register_file_size = 0x10U;
+
+/* Write-clear bits and the read-write bit of `INTR`. */
+constexpr std::uint32_t intr_write_clear_bits = 0x3U;
+constexpr std::uint32_t intr_enable_bit       = 0x100U;
+
+/**
+ * @brief Device model: handles the forwarded accesses and keeps a log of them. The log is only changed while a request
+ * is handled, so the driver can read it after its request returned.
+ */
+class model
+{
+public:
+    explicit model(const int file_descriptor) : channel{ file_descriptor, register_file_size } {}
+
+    /**
+     * @brief Serves requests until `stop` is requested.
+     */
+    void run(const std::stop_token& stop)
+    {
+        while (!stop.stop_requested())
+        {
+            static_cast<void>(channel.serve([this](const cosim_request& request) { return handle(request); }, 10));
+        }
+    }
+
+    /**
+     * @brief Raises interrupt bits, as the hardware would.
+     */
+    void raise(const std::uint32_t bits)
+    {
+        channel.register_at<std::uint32_t>(0x8U).fetch_or(bits);
+    }
+
+    [[nodiscard]] auto get(const std::size_t offset) const -> std::uint32_t
+    {
+        return channel.register_at<std::uint32_t>(offset).load();
+    }
+
+    std::vector<cosim_request> log;
+    std::vector<std::uint32_t> fifo;
+
+private:
+    cosim_channel channel;
+
+    auto handle(const cosim_request& request) -> std::uint64_t
+    {
+        log.push_back(request);
+
+        if (request.offset == 0xCU)
+        {
+            /* FIFO: each write pushes a byte; STATUS shows the level and READY. */
+            fifo.push_back(static_cast<std::uint32_t>(request.value));
+            channel.register_at<std::uint32_t>(0x4U).store(static_cast<std::uint32_t>((fifo.size() << 4U) | 0x1U));
+
+            return 0U;
+        }
+
+        const auto    intr  = channel.register_at<std::uint32_t>(0x8U);
+        const auto    value = static_cast<std::uint32_t>(request.value);
+        std::uint32_t state = intr.load();
+
+        switch (request.access)
+        {
+            case cosim_access::read:
+                return state;
+            case cosim_access::write:
+                state = (state & ~intr_enable_bit) | (value & intr_enable_bit);
+                break;
+            case cosim_access::write_set:
+                state |= value & intr_enable_bit;
+                break;
+            case cosim_access::write_clear:
+                state &= ~(value & intr_enable_bit);
+                break;
+            case cosim_access::write_xor:
+                state ^= value & intr_enable_bit;
+                break;
+        }
+
+        /* Any write of a 1 to a write-clear bit clears it. */
+        intr.store(state & ~(value & intr_write_clear_bits));
+
+        return 0U;
+    }
+};
+
+/**
+ * @brief Returns the header of the segment, read from the file.
+ */
+auto get_header(const int file_descriptor) -> cosim_header
+{
+    cosim_header header{};
+    check(::pread(file_descriptor, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)));
+    return header;
+}
+
+void test_plain_registers_use_shared_memory(model& device, const int file_descriptor)
+{
+    PERIPH::CTRL::set_fields_overwrite(PERIPH::CTRL::DIV::value{ 0x12U }, PERIPH::CTRL::ENABLE::value::one);
+    check(device.get(0x0U) == 0x1201U);
+
+    PERIPH::CTRL::clear_bits(PERIPH::CTRL::ENABLE{ PERIPH::CTRL::ENABLE::bit::BIT0 });
+    check(device.get(0x0U) == 0x1200U);
+    check(PERIPH::CTRL::get_fields<PERIPH::CTRL::DIV>().get() == 0x12U);
+
+    /* None of this went through the doorbell. */
+    const auto header = get_header(file_descriptor);
+    check(header.magic == cosim_channel::magic and header.request_sequence == 0U and header.response_sequence == 0U);
+    check(device.log.empty());
+}
+
+void test_side_effects_are_forwarded(model& device, const int file_descriptor)
+{
+    /* FIFO write: forwarded with its address, offset and width. The model updates STATUS, which is read directly. */
+    PERIPH::DATA::set_fields_overwrite(PERIPH::DATA::DATA_::value{ 0x5AU });
+    check(device.log.size() == 1U and device.fifo.size() == 1U and device.fifo[0] == 0x5AU);
+    check(device.log[0].access == cosim_access::write and device.log[0].address == PERIPH_BASE_ADDRESS + 0xCU and
+          device.log[0].offset == 0xCU and device.log[0].width == 4U and device.log[0].value == 0x5AU);
+
+    const auto status = PERIPH::STATUS::get_fields<PERIPH::STATUS::READY, PERIPH::STATUS::LEVEL>();
+    check(status.get<PERIPH::STATUS::READY>() == 1U and status.get<PERIPH::STATUS::LEVEL>() == 1U);
+    check(device.log.size() == 1U);
+
+    /* Write-clear register: the read is answered by the model, and the acknowledge clears only the pending bit. */
+    PERIPH::INTR::set_fields(PERIPH::INTR::EN::value::one);
+    device.raise(0x1U);
+    device.log.clear();
+
+    check(PERIPH::INTR::read_and_acknowledge<PERIPH::INTR::A>().get() == 1U);
+    check(device.get(0x8U) == intr_enable_bit);
+    check(!device.log.empty() and device.log[0].access == cosim_access::read);
+    check(device.log.back().access != cosim_access::read and (device.log.back().value & intr_write_clear_bits) == 0x1U);
+
+    /* Every forwarded access has been answered, and the lock is free again. */
+    const auto header = get_header(file_descriptor);
+    check(header.request_sequence == header.response_sequence and header.request_sequence >= 4U);
+    check(header.lock == 0U);
+}
+
+void test_concurrent_drivers(model& device, const int file_descriptor)
+{
+    constexpr std::uint32_t writes_per_thread = 200U;
+
+    device.fifo.clear();
+    const std::uint32_t first_sequence = get_header(file_descriptor).request_sequence;
+
+    /* Two driver threads share the doorbell: the lock keeps their requests apart. */
+    {
+        const auto writer = [](const std::uint32_t tag) {
+            for (std::uint32_t index = 0U; index < writes_per_thread; index++)
+            {
+                PERIPH::DATA::set_fields_overwrite(PERIPH::DATA::DATA_::value{ tag | (index & 0x7FU) });
+            }
+        };
+
+        const std::jthread first{ writer, 0x00U };
+        const std::jthread second{ writer, 0x80U };
+    }
+
+    check(device.fifo.size() == 2U * writes_per_thread);
+
+    /* Each thread's writes arrive in order. */
+    std::uint32_t expected[2] = { 0U, 0U };
+    bool          is_ordered  = true;
+
+    for (const std::uint32_t value : device.fifo)
+    {
+        auto& next = expected[value >> 7U];
+        is_ordered = is_ordered and (value & 0x7FU) == (next & 0x7FU);
+        next++;
+    }
+
+    check(is_ordered and expected[0] == writes_per_thread and expected[1] == writes_per_thread);
+
+    const auto header = get_header(file_descriptor);
+    check(header.request_sequence - first_sequence == 2U * writes_per_thread);
+    check(header.response_sequence == header.request_sequence and header.lock == 0U);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    const int file_descriptor = ::memfd_create("cosim_test", MFD_CLOEXEC);
+    check(file_descriptor >= 0);
+
+    cosim_channel driver_channel{ file_descriptor, register_file_size };
+    check(static_cast<bool>(driver_channel));
+    cosim::attach<PERIPH_BASE_ADDRESS>(driver_channel);
+
+    model device{ file_descriptor };
+
+    {
+        const std::jthread model_thread{ [&device](const std::stop_token& stop) { device.run(stop); } };
+
+        test_plain_registers_use_shared_memory(device, file_descriptor);
+        test_side_effects_are_forwarded(device, file_descriptor);
+        test_concurrent_drivers(device, file_descriptor);
+    }
+
+    ::close(file_descriptor);
+
+    return result();
+}
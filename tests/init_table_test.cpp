@@ -0,0 +1,71 @@
+/**
+ * @file init_table_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests init tables and deferred register writes on the simulator.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Built with `TSRI_OPTION_BACKEND_SIMULATOR`, so the default backend is the simulator and init tables can be applied to
+ * the test peripheral. The simulator does not clear write-clear bits, so a store that acknowledges a pending bit is
+ * visible as that bit being written back.
+ */
+#include "test.hpp"
+#include "test_peripheral.hpp"
+
+using sim = tsri::backends::simulator;
+using namespace test;
+
+namespace
+{
+
+/* CTRL is written three times, INTR once: the table has one entry per register, in the order of their last write. */
+constexpr auto& init = tsri::init::table<
+    PERIPH::CTRL::defer_set_fields_overwrite(PERIPH::CTRL::ENABLE::value::one),
+    PERIPH::INTR::defer_set_fields(PERIPH::INTR::EN::value::one),
+    PERIPH::CTRL::defer_set_fields(PERIPH::CTRL::DIV::value{ 5U }),
+    PERIPH::CTRL::defer_set_fields(PERIPH::CTRL::DIV::value{ 3U })>;
+
+static_assert(init.size() == 2U);
+static_assert(init[0].address == PERIPH_BASE_ADDRESS + 0x8U and init[0].keep_mask == 0U and init[0].value == 0x100U);
+static_assert(init[1].address == PERIPH_BASE_ADDRESS and init[1].keep_mask == 0U and init[1].value == 0x301U);
+
+/* The second write puts DIV back to its reset value, so CTRL is not written at all. */
+constexpr auto& back_to_reset = tsri::init::table<PERIPH::CTRL::defer_set_fields(PERIPH::CTRL::DIV::value{ 5U }),
+                                                  PERIPH::CTRL::defer_set_fields(PERIPH::CTRL::DIV::value{ 1U })>;
+
+static_assert(back_to_reset.empty());
+
+void test_table_writes_the_final_values()
+{
+    sim::clear();
+    sim::set(PERIPH_BASE_ADDRESS, 0x100U);
+    sim::set(PERIPH_BASE_ADDRESS + 0x8U, 0x1U);
+    sim::reset_counts();
+
+    tsri::init::apply(init);
+
+    /* The pending bit A is not written back, and no register is read. */
+    check(sim::get(PERIPH_BASE_ADDRESS) == 0x301U);
+    check(sim::get(PERIPH_BASE_ADDRESS + 0x8U) == 0x100U);
+    check(sim::reads() == 0U and sim::writes() == 2U);
+}
+
+void test_deferred_write_does_not_acknowledge()
+{
+    sim::clear();
+    sim::set(PERIPH_BASE_ADDRESS + 0x8U, 0x1U);
+
+    PERIPH::apply(PERIPH::INTR::defer_set_fields(PERIPH::INTR::EN::value::one));
+
+    check(sim::get(PERIPH_BASE_ADDRESS + 0x8U) == 0x100U);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    test_table_writes_the_final_values();
+    test_deferred_write_does_not_acknowledge();
+
+    return result();
+}
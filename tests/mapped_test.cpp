@@ -0,0 +1,219 @@
+/**
+ * @file mapped_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the mapped backend on a `memfd` that stands in for the device.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * A `memfd` is plain memory: a write-clear bit that is written back as 1 reads back as 1, and a bit that is written as 0
+ * reads back as 0. So after a read-modify-write, the write-clear bits that were pending must read as 0.
+ */
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "tsri/backends/backend.hpp"
+#include "tsri/backends/mapped.hpp"
+
+template<>
+struct tsri::backends::peripheral_backend<0x40000000U>
+{
+    using type = tsri::backends::mapped;
+};
+
+#include "test.hpp"
+#include "test_peripheral.hpp"
+
+using tsri::backends::alias_pages;
+using tsri::backends::mapped;
+using tsri::backends::mapped_region;
+using namespace test;
+
+namespace
+{
+
+/* Size of the register block and of each alias page. */
+constexpr std::size_t page_size = 0x1000U;
+
+/**
+ * @brief Returns the 32-bit word at byte `offset` of `region`.
+ */
+auto get_word(const mapped_region& region, const std::size_t offset) -> std::uint32_t
+{
+    std::uint32_t word = 0U;
+    std::memcpy(&word, region.data() + offset, sizeof(word));
+    return word;
+}
+
+/**
+ * @brief Sets the 32-bit word at byte `offset` of `region`, as the device would.
+ */
+void set_word(const mapped_region& region, const std::size_t offset, const std::uint32_t word)
+{
+    std::memcpy(region.data() + offset, &word, sizeof(word));
+}
+
+void test_read_write(const mapped_region& region)
+{
+    mapped::attach<PERIPH_BASE_ADDRESS>(region);
+
+    PERIPH::CTRL::set_fields_overwrite(PERIPH::CTRL::DIV::value{ 0x12U });
+    check(get_word(region, 0x0U) == 0x1200U);
+
+    PERIPH::CTRL::set_fields(PERIPH::CTRL::ENABLE::value::one);
+    check(get_word(region, 0x0U) == 0x1201U);
+
+    set_word(region, 0x4U, 0x51U);
+    const auto status = PERIPH::STATUS::get_fields<PERIPH::STATUS::READY, PERIPH::STATUS::LEVEL>();
+    check(status.get<PERIPH::STATUS::READY>() == 1U and status.get<PERIPH::STATUS::LEVEL>() == 5U);
+}
+
+void test_write_clear_bits_are_not_written_back(const mapped_region& region)
+{
+    mapped::attach<PERIPH_BASE_ADDRESS>(region);
+
+    /* Both interrupts are pending. Enabling and disabling must not acknowledge them. */
+    set_word(region, 0x8U, 0x3U);
+    PERIPH::INTR::set_bits(PERIPH::INTR::EN{ PERIPH::INTR::EN::bit::BIT0 });
+    check(get_word(region, 0x8U) == 0x100U);
+
+    set_word(region, 0x8U, 0x103U);
+    PERIPH::INTR::clear_bits(PERIPH::INTR::EN{ PERIPH::INTR::EN::bit::BIT0 });
+    check(get_word(region, 0x8U) == 0x0U);
+
+    set_word(region, 0x8U, 0x3U);
+    PERIPH::INTR::set_fields(PERIPH::INTR::EN::value::one);
+    check(get_word(region, 0x8U) == 0x100U);
+
+    /* Acknowledging A writes 1 to A only. */
+    set_word(region, 0x8U, 0x103U);
+    check(PERIPH::INTR::read_and_acknowledge<PERIPH::INTR::A>().get() == 1U);
+    check(get_word(region, 0x8U) == 0x101U);
+}
+
+void test_alias_pages(const mapped_region& region)
+{
+    mapped::attach<PERIPH_BASE_ADDRESS>(region, alias_pages::mapped);
+
+    set_word(region, 0x0U, 0x100U);
+    set_word(region, 0x2000U, 0U);
+    PERIPH::CTRL::set_bits(PERIPH::CTRL::ENABLE{ PERIPH::CTRL::ENABLE::bit::BIT0 });
+
+    /* The set went to the set alias, the register itself was not written. */
+    check(get_word(region, 0x2000U) == 0x1U);
+    check(get_word(region, 0x0U) == 0x100U);
+
+    PERIPH::CTRL::toggle_bits(PERIPH::CTRL::DIV{ PERIPH::CTRL::DIV::bit::BIT3 });
+    check(get_word(region, 0x1000U) == 0x800U);
+
+    mapped::attach<PERIPH_BASE_ADDRESS>(region);
+}
+
+void test_concurrent_read_modify_writes(const mapped_region& region)
+{
+    mapped::attach<PERIPH_BASE_ADDRESS>(region);
+
+    set_word(region, 0x0U, 0x0U);
+
+    /* Each thread toggles its own bit of DIV an odd number of times. A lost update would leave a bit cleared. */
+    constexpr unsigned threads    = 4U;
+    constexpr unsigned iterations = 20001U;
+
+    std::vector<std::thread> workers;
+
+    for (unsigned thread = 0U; thread < threads; thread++)
+    {
+        workers.emplace_back([thread] {
+            for (unsigned iteration = 0U; iteration < iterations; iteration++)
+            {
+                PERIPH::CTRL::toggle_bits(PERIPH::CTRL::DIV{ PERIPH::CTRL::DIV::bit{ thread } });
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    check(get_word(region, 0x0U) == 0xF00U);
+}
+
+void test_acknowledge_keeps_concurrent_modifications(const mapped_region& region)
+{
+    mapped::attach<PERIPH_BASE_ADDRESS>(region);
+
+    set_word(region, 0x8U, 0x0U);
+
+    /* One thread toggles EN an odd number of times, while the other acknowledges A. An acknowledge that wrote back a
+     * stale EN would undo a toggle.
+     */
+    constexpr unsigned iterations = 20001U;
+
+    std::thread toggler([] {
+        for (unsigned iteration = 0U; iteration < iterations; iteration++)
+        {
+            PERIPH::INTR::toggle_bits(PERIPH::INTR::EN{ PERIPH::INTR::EN::bit::BIT0 });
+        }
+    });
+
+    unsigned acknowledged = 0U;
+
+    for (unsigned iteration = 0U; iteration < iterations; iteration++)
+    {
+        acknowledged += PERIPH::INTR::read_and_acknowledge<PERIPH::INTR::A>().get();
+    }
+
+    toggler.join();
+
+    check(acknowledged == 0U);
+    check(get_word(region, 0x8U) == 0x100U);
+}
+
+void test_dispatch_keeps_modifications_by_handlers(const mapped_region& region)
+{
+    mapped::attach<PERIPH_BASE_ADDRESS>(region);
+
+    /* A and B are pending, and the handler of A disables the interrupt while it runs. */
+    set_word(region, 0x8U, 0x103U);
+
+    const auto handled = PERIPH::INTR::dispatch_and_acknowledge<tsri::interrupts::handler<PERIPH::INTR::A, [] {
+        PERIPH::INTR::clear_bits(PERIPH::INTR::EN{ PERIPH::INTR::EN::bit::BIT0 });
+    }>>();
+
+    /* Only A was acknowledged, and the handler's change to EN was kept. */
+    check(handled == 0x1U);
+    check(get_word(region, 0x8U) == 0x1U);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    const int file_descriptor = ::memfd_create("tsri_mapped_test", MFD_CLOEXEC);
+
+    check(file_descriptor >= 0 and ::ftruncate(file_descriptor, 4U * page_size) == 0);
+
+    const mapped_region registers{ file_descriptor, 0, page_size };
+    const mapped_region with_aliases{ file_descriptor, 0, 4U * page_size };
+
+    ::close(file_descriptor);
+
+    check(static_cast<bool>(registers) and registers.size() == page_size);
+    check(static_cast<bool>(with_aliases) and with_aliases.size() == 4U * page_size);
+
+    test_read_write(registers);
+    test_write_clear_bits_are_not_written_back(registers);
+    test_alias_pages(with_aliases);
+    test_concurrent_read_modify_writes(registers);
+    test_acknowledge_keeps_concurrent_modifications(registers);
+    test_dispatch_keeps_modifications_by_handlers(registers);
+
+    mapped::attach<PERIPH_BASE_ADDRESS>(nullptr);
+
+    return result();
+}
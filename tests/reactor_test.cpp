@@ -0,0 +1,135 @@
+/**
+ * @file reactor_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the epoll reactor with an `eventfd` in place of a UIO device.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * The registers of the test peripheral are in a `memfd` through the mapped backend, so the test can raise an interrupt
+ * like the device would: set the status bits, then signal the `eventfd`.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "tsri/backends/backend.hpp"
+#include "tsri/backends/mapped.hpp"
+
+template<>
+struct tsri::backends::peripheral_backend<0x40000000U>
+{
+    using type = tsri::backends::mapped;
+};
+
+#include "tsri/async/reactor.hpp"
+#include "test.hpp"
+#include "test_peripheral.hpp"
+
+using tsri::backends::mapped;
+using tsri::backends::mapped_region;
+using namespace test;
+
+namespace
+{
+
+/* Number of calls of the handler, and the status bits it got in the last call. */
+unsigned handler_calls  = 0U;
+unsigned handler_status = 0U;
+
+/**
+ * @brief Handler of the interrupt, records the values of A (bit 0) and B (bit 1).
+ */
+void on_interrupt(const tsri::utility::types::type_map<PERIPH::INTR::A, PERIPH::INTR::B>& status) noexcept
+{
+    handler_status = status.get<PERIPH::INTR::A>() | (status.get<PERIPH::INTR::B>() << 1U);
+    handler_calls++;
+}
+
+/**
+ * @brief Returns the 32-bit word at byte `offset` of `region`.
+ */
+auto get_word(const mapped_region& region, const std::size_t offset) -> std::uint32_t
+{
+    std::uint32_t word = 0U;
+    std::memcpy(&word, region.data() + offset, sizeof(word));
+    return word;
+}
+
+/**
+ * @brief Sets the 32-bit word at byte `offset` of `region`, as the device would.
+ */
+void set_word(const mapped_region& region, const std::size_t offset, const std::uint32_t word)
+{
+    std::memcpy(region.data() + offset, &word, sizeof(word));
+}
+
+/**
+ * @brief Raises the interrupt by signalling the `eventfd`.
+ */
+void raise(const int event_descriptor)
+{
+    const std::uint64_t one = 1U;
+
+    check(::write(event_descriptor, &one, sizeof(one)) == sizeof(one));
+}
+
+void test_interrupt_is_handled_once(const mapped_region& region, const int event_descriptor)
+{
+    tsri::async::register_interrupt<PERIPH::INTR, &on_interrupt, PERIPH::INTR::A, PERIPH::INTR::B> interrupt{
+        event_descriptor, tsri::async::interrupt_source::kind::event
+    };
+    tsri::async::reactor reactor;
+
+    check(reactor.is_valid());
+    check(reactor.add(interrupt));
+
+    /* Nothing is pending yet. */
+    check(reactor.poll(0) == 0);
+    check(handler_calls == 0U);
+
+    /* B is pending and the interrupt is enabled. Two signals before the poll are one interrupt. */
+    set_word(region, 0x8U, 0x102U);
+    raise(event_descriptor);
+    raise(event_descriptor);
+
+    check(reactor.poll(100) == 1);
+    check(handler_calls == 1U);
+    check(handler_status == 0x2U);
+
+    /* The store acknowledged B only, and kept the enable bit. */
+    check(get_word(region, 0x8U) == 0x102U);
+
+    /* The event was consumed. */
+    check(reactor.poll(0) == 0);
+    check(handler_calls == 1U);
+
+    reactor.remove(interrupt);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    const int file_descriptor = ::memfd_create("tsri_reactor_test", MFD_CLOEXEC);
+
+    check(file_descriptor >= 0 and ::ftruncate(file_descriptor, 0x1000) == 0);
+
+    const mapped_region registers{ file_descriptor, 0, 0x1000U };
+
+    ::close(file_descriptor);
+    mapped::attach<PERIPH_BASE_ADDRESS>(registers);
+
+    const int event_descriptor = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    check(event_descriptor >= 0);
+
+    test_interrupt_is_handled_once(registers, event_descriptor);
+
+    ::close(event_descriptor);
+    mapped::attach<PERIPH_BASE_ADDRESS>(nullptr);
+
+    return result();
+}
@@ -0,0 +1,160 @@
+/**
+ * @file scheduler_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the async scheduler on the simulator.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Built with `TSRI_OPTION_BACKEND_SIMULATOR` and a task frame pool of two slots, so that exhausting the pool is
+ * cheap to test.
+ */
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "test.hpp"
+#include "test_peripheral.hpp"
+#include "tsri/async/scheduler.hpp"
+
+using sim = tsri::backends::simulator;
+using namespace test;
+
+namespace
+{
+
+constexpr auto STATUS_ADDRESS = PERIPH_BASE_ADDRESS + 0x4U;
+constexpr auto INTR_ADDRESS   = PERIPH_BASE_ADDRESS + 0x8U;
+
+/* Order in which the tasks were resumed. */
+struct resume_log
+{
+    std::array<int, 8U> ids{};
+    std::size_t         count = 0U;
+
+    void add(const int id) noexcept
+    {
+        ids[count++] = id;
+    }
+};
+
+auto wait_ready(const int id, resume_log* const log) -> tsri::async::task
+{
+    co_await PERIPH::STATUS::until_all_bits_set(PERIPH::STATUS::READY{ PERIPH::STATUS::READY::bit::BIT0 });
+    log->add(id);
+}
+
+auto wait_level(const int id, resume_log* const log) -> tsri::async::task
+{
+    const auto value =
+        co_await PERIPH::STATUS::until_all_bits_set(PERIPH::STATUS::LEVEL{ PERIPH::STATUS::LEVEL::bit::BIT0 });
+    check((value & 0xF0U) == 0x50U);
+    log->add(id);
+}
+
+auto wait_intr(const int id, resume_log* const log) -> tsri::async::task
+{
+    co_await PERIPH::INTR::until_any_bit_set(PERIPH::INTR::A{ PERIPH::INTR::A::bit::BIT0 });
+    log->add(id);
+}
+
+void test_one_read_per_register_per_tick()
+{
+    sim::clear();
+
+    tsri::async::scheduler scheduler;
+    resume_log             log;
+
+    check(scheduler.spawn(wait_ready(0, &log)));
+    check(scheduler.spawn(wait_level(1, &log)));
+    check(log.count == 0U and !scheduler.is_idle());
+
+    /* Two conditions on STATUS: one read of STATUS per tick. */
+    sim::reset_counts();
+    check(scheduler.tick());
+    check(scheduler.tick());
+    check(sim::reads(STATUS_ADDRESS) == 2U and sim::reads() == 2U);
+
+    /* Satisfying one condition resumes only its task; the other one stays pending. */
+    sim::set(STATUS_ADDRESS, 0x1U);
+    sim::reset_counts();
+    check(scheduler.tick());
+    check(sim::reads() == 1U);
+    check(log.count == 1U and log.ids[0] == 0);
+
+    sim::set(STATUS_ADDRESS, 0x51U);
+    check(!scheduler.tick());
+    check(log.count == 2U and log.ids[1] == 1);
+    check(scheduler.is_idle());
+    check(tsri::async::task_frame_pool::get_used_slot_count() == 0U);
+}
+
+void test_resumption_order()
+{
+    sim::clear();
+
+    tsri::async::scheduler scheduler;
+    resume_log             log;
+
+    /* Spawned in descending register order. */
+    check(scheduler.spawn(wait_intr(0, &log)));
+    check(scheduler.spawn(wait_ready(1, &log)));
+
+    /* Both conditions hold in the same tick: sorted by address, INTR after STATUS. Each register is read once. */
+    sim::set(STATUS_ADDRESS, 0x1U);
+    sim::set(INTR_ADDRESS, 0x1U);
+    sim::reset_counts();
+    check(!scheduler.tick());
+    check(sim::reads(STATUS_ADDRESS) == 1U and sim::reads(INTR_ADDRESS) == 1U);
+    check(log.count == 2U and log.ids[0] == 1 and log.ids[1] == 0);
+
+    /* Conditions on the same register are resumed in the order in which they were awaited. */
+    sim::clear();
+    log = {};
+
+    check(scheduler.spawn(wait_level(0, &log)));
+    check(scheduler.spawn(wait_ready(1, &log)));
+
+    sim::set(STATUS_ADDRESS, 0x51U);
+    scheduler.run();
+    check(log.count == 2U and log.ids[0] == 0 and log.ids[1] == 1);
+}
+
+void test_frame_pool_exhaustion()
+{
+    sim::clear();
+
+    tsri::async::scheduler scheduler;
+    resume_log             log;
+
+    check(scheduler.spawn(wait_ready(0, &log)));
+    check(scheduler.spawn(wait_ready(1, &log)));
+    check(tsri::async::task_frame_pool::get_used_slot_count() == 2U);
+
+    /* The pool has two slots: the third frame can not be allocated, so the task is invalid and not started. */
+    auto exhausted = wait_ready(2, &log);
+    check(!exhausted.is_valid());
+    check(!scheduler.spawn(std::move(exhausted)));
+    check(tsri::async::task_frame_pool::get_used_slot_count() == 2U);
+
+    /* Finished tasks free their slots. */
+    sim::set(STATUS_ADDRESS, 0x1U);
+    scheduler.run();
+    check(log.count == 2U);
+    check(tsri::async::task_frame_pool::get_used_slot_count() == 0U);
+
+    /* A task that does not suspend frees its slot right away. */
+    check(scheduler.spawn(wait_ready(3, &log)));
+    check(log.count == 3U and log.ids[2] == 3);
+    check(tsri::async::task_frame_pool::get_used_slot_count() == 0U);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    test_one_read_per_register_per_tick();
+    test_resumption_order();
+    test_frame_pool_exhaustion();
+
+    return result();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file shared_access_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the out-of-line register accesses on the simulator, with tracing.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Built with `TSRI_OPTION_BACKEND_SIMULATOR` and `TSRI_OPTION_TRACE`, so the backend of the test peripheral is the
+ * traced default backend. Out-of-line operations must then reach the simulator and the trace exactly like inlined ones.
+ */
+#include <cstdint>
+#include <vector>
+
+#include "test.hpp"
+#include "test_peripheral.hpp"
+
+using sim = tsri::backends::simulator;
+using tsri::registers::inlined;
+using tsri::registers::out_of_line;
+using namespace test;
+
+namespace
+{
+
+/**
+ * @brief Returns the trace entries that were recorded since the trace was last cleared.
+ */
+auto take_trace() -> std::vector<std::uint64_t>
+{
+    auto& trace = tsri::backends::trace_buffer;
+
+    std::vector<std::uint64_t> entries(trace.entries.begin(), trace.entries.begin() + trace.position);
+
+    trace.position = 0U;
+
+    return entries;
+}
+
+/**
+ * @brief Runs `operation` with the simulator in the same state, and returns the trace and the register value.
+ */
+template<typename Operation>
+auto run(const std::uint32_t address, const std::uint32_t value, Operation operation)
+    -> std::pair<std::vector<std::uint64_t>, std::uint64_t>
+{
+    sim::clear();
+    sim::set(address, value);
+    take_trace();
+
+    operation();
+
+    return { take_trace(), sim::get(address) };
+}
+
+void test_registers_support_shared_access()
+{
+    check(tsri::registers::shared::traced_backend_t::get_register_tag<PERIPH_BASE_ADDRESS>(0x8U) != 0U);
+
+    const auto inlined_set = run(PERIPH_BASE_ADDRESS, 0x100U, []() {
+        PERIPH::CTRL::set_fields(inlined, PERIPH::CTRL::DIV::value{ 7U });
+    });
+    const auto shared_set = run(PERIPH_BASE_ADDRESS, 0x100U, []() {
+        PERIPH::CTRL::set_fields(out_of_line, PERIPH::CTRL::DIV::value{ 7U });
+    });
+
+    check(shared_set.second == 0x700U);
+    check(shared_set == inlined_set);
+    check(shared_set.first.size() == 2U);
+}
+
+void test_write_is_traced()
+{
+    const auto inlined_write = run(PERIPH_BASE_ADDRESS + 0xCU, 0U, []() {
+        PERIPH::DATA::set_fields_overwrite(inlined, PERIPH::DATA::DATA_::value{ 0x5AU });
+    });
+    const auto shared_write = run(PERIPH_BASE_ADDRESS + 0xCU, 0U, []() {
+        PERIPH::DATA::set_fields_overwrite(out_of_line, PERIPH::DATA::DATA_::value{ 0x5AU });
+    });
+
+    check(shared_write.second == 0x5AU);
+    check(shared_write == inlined_write);
+    check(shared_write.first.size() == 1U);
+}
+
+void test_write_clear_bits_are_not_written_back()
+{
+    const auto shared_set = run(PERIPH_BASE_ADDRESS + 0x8U, 0x3U, []() {
+        PERIPH::INTR::set_fields(out_of_line, PERIPH::INTR::EN::value::one);
+    });
+
+    check(shared_set.second == 0x100U);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    test_registers_support_shared_access();
+    test_write_is_traced();
+    test_write_clear_bits_are_not_written_back();
+
+    return result();
+}
@@ -0,0 +1,30 @@
+/**
+ * @file shared_section_ram.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Translation unit of `shared_section_test` that places the shared access functions in a section.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Built with `TSRI_OPTION_SHARED_ACCESS_SECTION` defined as `"tsri_shared"`, while the rest of the test is not.
+ */
+#include <cstdint>
+
+#include "test_peripheral.hpp"
+
+using namespace test;
+
+/**
+ * @brief Sets `CTRL.DIV` with the shared functions of this translation unit.
+ */
+void set_div_from_section(const std::uint32_t div)
+{
+    PERIPH::CTRL::set_fields(tsri::registers::out_of_line, PERIPH::CTRL::DIV::value{ div });
+}
+
+/**
+ * @brief Returns the address of the shared `modify` of this translation unit.
+ */
+auto get_section_modify_address() -> std::uintptr_t
+{
+    return reinterpret_cast<std::uintptr_t>(&tsri::registers::shared::functions_t::modify);
+}
@@ -0,0 +1,69 @@
+/**
+ * @file shared_section_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests that translation units with another shared access section get their own shared access functions.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Built with `TSRI_OPTION_BACKEND_SIMULATOR`. This translation unit does not define
+ * `TSRI_OPTION_SHARED_ACCESS_SECTION`, `shared_section_ram.cpp` defines it as `"tsri_shared"`. The linker defines
+ * `__start_tsri_shared` and `__stop_tsri_shared` around that section, so the test can check where each copy of the
+ * shared functions ended up.
+ */
+#include <cstdint>
+
+#include "test.hpp"
+#include "test_peripheral.hpp"
+
+extern "C" const char __start_tsri_shared[];
+extern "C" const char __stop_tsri_shared[];
+
+void set_div_from_section(std::uint32_t div);
+auto get_section_modify_address() -> std::uintptr_t;
+
+using sim = tsri::backends::simulator;
+using namespace test;
+
+namespace
+{
+
+/**
+ * @brief Returns `true` if `address` is in the `tsri_shared` section.
+ */
+auto is_in_section(const std::uintptr_t address) -> bool
+{
+    return address >= reinterpret_cast<std::uintptr_t>(__start_tsri_shared) and
+           address < reinterpret_cast<std::uintptr_t>(__stop_tsri_shared);
+}
+
+void test_each_section_has_its_own_functions()
+{
+    const auto modify_address = reinterpret_cast<std::uintptr_t>(&tsri::registers::shared::functions_t::modify);
+
+    check(is_in_section(get_section_modify_address()));
+    check(not is_in_section(modify_address));
+}
+
+void test_both_copies_access_the_register()
+{
+    sim::clear();
+    sim::set(PERIPH_BASE_ADDRESS, 0x100U);
+
+    PERIPH::CTRL::set_fields(tsri::registers::out_of_line, PERIPH::CTRL::DIV::value{ 3U });
+
+    check(sim::get(PERIPH_BASE_ADDRESS) == 0x300U);
+
+    set_div_from_section(5U);
+
+    check(sim::get(PERIPH_BASE_ADDRESS) == 0x500U);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    test_each_section_has_its_own_functions();
+    test_both_copies_access_the_register();
+
+    return result();
+}
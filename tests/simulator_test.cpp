@@ -0,0 +1,152 @@
+/**
+ * @file simulator_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the device models and the virtual time of the simulator.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Built with `TSRI_OPTION_BACKEND_SIMULATOR`. Every register access takes one cycle, so the number of reads that a
+ * wait loop needs is exact, and is checked against the delays of the device models.
+ */
+#include <cstdint>
+
+#include "test.hpp"
+#include "test_peripheral.hpp"
+
+using sim = tsri::backends::simulator;
+using namespace test;
+
+namespace
+{
+
+constexpr auto CTRL_ADDRESS   = PERIPH_BASE_ADDRESS;
+constexpr auto STATUS_ADDRESS = PERIPH_BASE_ADDRESS + 0x4U;
+constexpr auto INTR_ADDRESS   = PERIPH_BASE_ADDRESS + 0x8U;
+
+constexpr std::uint64_t ENABLE = 0x1U;
+constexpr std::uint64_t READY  = 0x1U;
+
+/* Cycles from enabling the PLL until it is locked. */
+constexpr sim::cycles_t LOCK_DELAY = 10U;
+
+/**
+ * @brief PLL model: `STATUS.READY` is the lock bit. It is set `LOCK_DELAY` cycles after `CTRL.ENABLE` is set, and
+ * cleared right away when `CTRL.ENABLE` is cleared.
+ */
+void add_pll_model()
+{
+    sim::on_write(CTRL_ADDRESS, [](const std::uint64_t value) {
+        if ((value & ENABLE) == 0U)
+        {
+            sim::set(STATUS_ADDRESS, sim::get(STATUS_ADDRESS) & ~READY);
+        }
+        else if ((sim::get(STATUS_ADDRESS) & READY) == 0U)
+        {
+            sim::schedule(LOCK_DELAY, [] {
+                /* Only lock if the PLL was not disabled in the meantime. */
+                if ((sim::get(CTRL_ADDRESS) & ENABLE) != 0U)
+                {
+                    sim::set(STATUS_ADDRESS, sim::get(STATUS_ADDRESS) | READY);
+                }
+            });
+        }
+    });
+}
+
+void test_wait_for_pll_lock()
+{
+    sim::clear();
+    add_pll_model();
+
+    PERIPH::CTRL::set_fields(PERIPH::CTRL::ENABLE::value::one);
+    check(sim::get(STATUS_ADDRESS) == 0U);
+
+    /* The lock event is due at the 10th access after the write and runs before it, so the 10th read sees the lock. */
+    sim::reset_counts();
+    PERIPH::STATUS::wait_until_all_bits_set(PERIPH::STATUS::READY{ PERIPH::STATUS::READY::bit::BIT0 });
+    check(sim::reads(STATUS_ADDRESS) == LOCK_DELAY and sim::reads() == LOCK_DELAY);
+
+    /* Disabling unlocks at once. */
+    PERIPH::CTRL::set_fields(PERIPH::CTRL::ENABLE::value::zero);
+    sim::reset_counts();
+    PERIPH::STATUS::wait_until_all_bits_cleared(PERIPH::STATUS::READY{ PERIPH::STATUS::READY::bit::BIT0 });
+    check(sim::reads() == 1U);
+}
+
+void test_wait_times_out_before_lock()
+{
+    sim::clear();
+    add_pll_model();
+
+    PERIPH::CTRL::set_fields(PERIPH::CTRL::ENABLE::value::one);
+
+    /* One read, and three more before the policy gives up: too early for the lock. */
+    sim::reset_counts();
+    check(!PERIPH::STATUS::wait_until_all_bits_set(tsri::polling::spin_count<>{ 3U },
+                                                   PERIPH::STATUS::READY{ PERIPH::STATUS::READY::bit::BIT0 }));
+    check(sim::reads() == 4U);
+
+    /* Waiting longer than the delay, without register accesses, runs the lock event: the next read succeeds. */
+    sim::advance(LOCK_DELAY);
+    check(sim::get(STATUS_ADDRESS) == READY);
+
+    sim::reset_counts();
+    check(PERIPH::STATUS::wait_until_all_bits_set(tsri::polling::spin_count<>{ 3U },
+                                                  PERIPH::STATUS::READY{ PERIPH::STATUS::READY::bit::BIT0 }));
+    check(sim::reads() == 1U);
+}
+
+void test_periodic_event()
+{
+    sim::clear();
+
+    /* A level that goes up every 4 cycles, by an event that schedules itself again. */
+    struct level_model
+    {
+        static void tick()
+        {
+            sim::set(STATUS_ADDRESS, sim::get(STATUS_ADDRESS) + 0x10U);
+            sim::schedule(4U, &tick);
+        }
+    };
+
+    sim::schedule(4U, &level_model::tick);
+
+    /* Time passes without accesses: the events due at cycles 4 and 8 run, and no register is read. */
+    sim::advance(8U);
+    check(sim::now() == 8U and sim::reads() == 0U);
+    check(sim::get(STATUS_ADDRESS) == 0x20U);
+
+    /* The next event is due at cycle 12, so the level reaches 3 at the 4th read. */
+    check(PERIPH::STATUS::wait_until<PERIPH::STATUS::LEVEL>(
+        [](const auto& fields) { return fields.get() >= 3U; }, tsri::polling::spin_count<>{ 100U }));
+    check(sim::reads() == 4U and sim::now() == 12U);
+}
+
+void test_read_hook_runs_before_the_read()
+{
+    sim::clear();
+
+    /* Interrupt A is raised on the 3rd read of INTR; the read that raises it already returns it. */
+    sim::on_read(INTR_ADDRESS, [] {
+        if (sim::reads(INTR_ADDRESS) == 3U)
+        {
+            sim::set(INTR_ADDRESS, sim::get(INTR_ADDRESS) | 0x1U);
+        }
+    });
+
+    PERIPH::INTR::wait_until_any_bit_set(PERIPH::INTR::A{ PERIPH::INTR::A::bit::BIT0 });
+    check(sim::reads(INTR_ADDRESS) == 3U and sim::writes() == 0U);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    test_wait_for_pll_lock();
+    test_wait_times_out_before_lock();
+    test_periodic_event();
+    test_read_hook_runs_before_the_read();
+
+    return result();
+}
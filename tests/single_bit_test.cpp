@@ -0,0 +1,93 @@
+/**
+ * @file single_bit_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the single-bit operations with runtime bit positions on the simulator.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Built with `TSRI_OPTION_BACKEND_SIMULATOR`. The register below has no atomic aliases, so the single-bit operations are
+ * read-modify-writes. It has a write-clear bit, which must not be written back while it is pending.
+ */
+#include "test.hpp"
+#include "tsri/tsri.hpp"
+
+using sim = tsri::backends::simulator;
+using namespace test;
+
+namespace
+{
+
+/* Base address of the peripheral. */
+constexpr tsri::utility::types::register_address_t FLAGS_BASE_ADDRESS = 0x50000000U;
+
+using flags_pend_base_t = tsri::fields::field<0U, 1U, tsri::fields::field_types::write_clear, 0, FLAGS_BASE_ADDRESS>;
+using flags_mode_base_t = tsri::fields::field<8U, 8U, tsri::fields::field_types::read_write, 0, FLAGS_BASE_ADDRESS>;
+
+struct FLAGS :
+    public tsri::registers::register_read_write<FLAGS_BASE_ADDRESS, 0x0U, 32U, 0U, false, flags_pend_base_t,
+                                                flags_mode_base_t>
+{
+    struct MODE : public flags_mode_base_t
+    {
+        using flags_mode_base_t::flags_mode_base_t;
+
+        struct bit : public flags_mode_base_t::bit
+        {
+            using flags_mode_base_t::bit::bit;
+        };
+    };
+};
+
+void test_bit_functions()
+{
+    static_assert(tsri::utility::bits::set_bit(0x1U, 4U) == 0x11U);
+    static_assert(tsri::utility::bits::clear_bit(0x11U, 4U) == 0x1U);
+    static_assert(tsri::utility::bits::invert_bit(0x11U, 0U) == 0x10U);
+    static_assert(tsri::utility::bits::extract_bit(0x10U, 4U) == 1U);
+
+    /* Positions that are only known at runtime. */
+    volatile tsri::utility::types::register_size_t position = 31U;
+
+    check(tsri::utility::bits::set_bit(0U, position) == 0x80000000U);
+    check(tsri::utility::bits::clear_bit(0xFFFFFFFFU, position) == 0x7FFFFFFFU);
+    check(tsri::utility::bits::invert_bit(0x80000000U, position) == 0U);
+    check(tsri::utility::bits::extract_bit(0x80000000U, position) == 1U);
+}
+
+void test_single_bits_keep_pending_write_clear_bits()
+{
+    const auto position = static_cast<tsri::utility::types::register_size_t>(sim::get(FLAGS_BASE_ADDRESS + 0x4U));
+
+    sim::set(FLAGS_BASE_ADDRESS, 0x1U);
+    FLAGS::set_bits(FLAGS::MODE{ FLAGS::MODE::bit{ position } });
+
+    check(sim::get(FLAGS_BASE_ADDRESS) == 0x200U);
+
+    sim::set(FLAGS_BASE_ADDRESS, 0x1U);
+    FLAGS::set_bit(FLAGS::MODE::bit{ position });
+
+    check(sim::get(FLAGS_BASE_ADDRESS) == 0x200U);
+
+    sim::set(FLAGS_BASE_ADDRESS, 0x301U);
+    FLAGS::clear_bit(FLAGS::MODE::bit{ position });
+
+    check(sim::get(FLAGS_BASE_ADDRESS) == 0x100U);
+
+    sim::set(FLAGS_BASE_ADDRESS, 0x101U);
+    FLAGS::toggle_bit(FLAGS::MODE::bit{ position });
+
+    check(sim::get(FLAGS_BASE_ADDRESS) == 0x300U);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    /* The bit position is read from the simulator, so the compiler can not fold it. */
+    sim::set(FLAGS_BASE_ADDRESS + 0x4U, 1U);
+
+    test_bit_functions();
+    test_single_bits_keep_pending_write_clear_bits();
+
+    return result();
+}
@@ -0,0 +1,77 @@
+# Checks the code of 'zbs_size_check.cpp' for RV32 cores with Zbs. Run with 'cmake -P', see CMakeLists.txt.
+#
+# The source is compiled twice with clang for riscv32, without and with Zbs. Each checked function must contain the
+# Zbs instruction at the end of its name (e.g. 'set_bit_bset') in the Zbs build, and must not be larger than in the
+# build without Zbs. The byte counts of both builds are printed.
+#
+# Arguments:
+#   CLANG              Path to clang++.
+#   OBJDUMP            Path to llvm-objdump.
+#   SOURCE             Source file to compile.
+#   INCLUDE_DIRECTORY  TSRI include directory.
+#   WORK_DIRECTORY     Directory for the object files.
+
+set(TSRI_CHECKED_FUNCTIONS set_bits_bset set_bit_bset clear_bit_bclr toggle_bit_binv extract_bit_bext get_ready_bexti)
+
+# Compiles SOURCE for 'ARCH', and sets 'OBJECT' to the object file.
+function(tsri_compile ARCH OBJECT)
+    set(object_file "${WORK_DIRECTORY}/zbs_size_check_${ARCH}.o")
+    execute_process(
+        COMMAND ${CLANG} --target=riscv32-unknown-elf -march=${ARCH} -mabi=ilp32 -std=c++23 -Os -fno-exceptions
+            -fno-rtti -I${INCLUDE_DIRECTORY} -c ${SOURCE} -o ${object_file}
+        RESULT_VARIABLE result
+        ERROR_VARIABLE errors
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Compiling for ${ARCH} failed:\n${errors}")
+    endif()
+    set(${OBJECT} ${object_file} PARENT_SCOPE)
+endfunction()
+
+# Sets 'SIZE' to the size in bytes of 'FUNCTION' in 'OBJECT'.
+function(tsri_get_size OBJECT FUNCTION SIZE)
+    execute_process(COMMAND ${OBJDUMP} -t ${OBJECT} OUTPUT_VARIABLE symbols)
+    if(NOT symbols MATCHES "[ \t]([0-9a-f]+) ${FUNCTION}\n")
+        message(FATAL_ERROR "${FUNCTION} is not in ${OBJECT}.")
+    endif()
+    math(EXPR size "0x${CMAKE_MATCH_1}")
+    set(${SIZE} ${size} PARENT_SCOPE)
+endfunction()
+
+tsri_compile(rv32imac object_base)
+tsri_compile(rv32imac_zbs object_zbs)
+
+set(failures 0)
+set(total_base 0)
+set(total_zbs 0)
+
+foreach(function IN LISTS TSRI_CHECKED_FUNCTIONS)
+    string(REGEX REPLACE "^.*_" "" instruction ${function})
+
+    tsri_get_size(${object_base} ${function} size_base)
+    tsri_get_size(${object_zbs} ${function} size_zbs)
+    math(EXPR total_base "${total_base} + ${size_base}")
+    math(EXPR total_zbs "${total_zbs} + ${size_zbs}")
+
+    execute_process(
+        COMMAND ${OBJDUMP} -d --no-show-raw-insn --mattr=+zbs,+c --disassemble-symbols=${function} ${object_zbs}
+        OUTPUT_VARIABLE disassembly
+    )
+
+    set(status "ok")
+    if(NOT disassembly MATCHES "[ \t]${instruction}[ \t]")
+        set(status "no ${instruction}")
+        math(EXPR failures "${failures} + 1")
+    elseif(size_zbs GREATER size_base)
+        set(status "larger with Zbs")
+        math(EXPR failures "${failures} + 1")
+    endif()
+
+    message(STATUS "${function}: ${size_base} -> ${size_zbs} bytes, ${status}")
+endforeach()
+
+message(STATUS "total: ${total_base} -> ${total_zbs} bytes")
+
+if(failures GREATER 0)
+    message(FATAL_ERROR "${failures} functions failed the Zbs check.")
+endif()
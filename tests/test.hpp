@@ -0,0 +1,44 @@
+/**
+ * @file test.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Minimal checks for the host tests.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Each test is an executable that returns 0 if all checks passed. Failed checks are printed with their location.
+ */
+#pragma once
+
+#include <cstdio>
+#include <source_location>
+
+namespace test
+{
+
+/* Number of checks that failed. */
+inline int failures = 0;
+
+/**
+ * @brief Records a failure if `condition` is `false`.
+ *
+ * @param condition Condition that must hold.
+ * @param location Location of the check, filled in by the compiler.
+ */
+inline void check(const bool condition, const std::source_location location = std::source_location::current())
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "%s:%u: check failed\n", location.file_name(), static_cast<unsigned>(location.line()));
+        failures++;
+    }
+}
+
+/**
+ * @brief Returns the exit code of the test: 0 if all checks passed.
+ */
+inline auto result() -> int
+{
+    return failures == 0 ? 0 : 1;
+}
+
+}  // namespace test
@@ -0,0 +1,184 @@
+/**
+ * @file test_peripheral.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Peripheral used by the host tests, in the form that the code generator emits.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * The tests do not depend on an SVD file: this header is written by hand, in the same form as a generated peripheral
+ * header. Tests select the backend of the peripheral by specializing `tsri::backends::peripheral_backend` for
+ * `test::PERIPH_BASE_ADDRESS` before including this header.
+ *
+ * - `CTRL` (0x0): read-write, with atomic aliases. `ENABLE` (bit 0), `DIV` (bits 8-15, reset 1), `START` (bit 20,
+ *   self-clearing).
+ * - `STATUS` (0x4): read-only. `READY` (bit 0), `LEVEL` (bits 4-7).
+ * - `INTR` (0x8): read-write, with atomic aliases. `A` and `B` (bits 0 and 1, write-clear), `EN` (bit 8).
+ * - `DATA` (0xC): write-only. `DATA_` (bits 0-7).
+ */
+#pragma once
+
+#include "tsri/tsri.hpp"
+
+namespace test
+{
+
+inline constexpr tsri::utility::types::register_address_t PERIPH_BASE_ADDRESS = 0x40000000U;
+
+class PERIPH : public tsri::peripherals::peripheral<0x40000000U>, public tsri::peripherals::retained_registers<0x40000000U>
+{
+private:
+    using ctrl_enable_base_t = tsri::fields::field<0U, 1U, tsri::fields::field_types::read_write, 0, 1073741824>;
+    using ctrl_div_base_t = tsri::fields::field<8U, 8U, tsri::fields::field_types::read_write, 1, 1073741824>;
+    using ctrl_start_base_t = tsri::fields::field<20U, 1U, tsri::fields::field_types::self_clearing, 0, 1073741824>;
+    using status_ready_base_t = tsri::fields::field<0U, 1U, tsri::fields::field_types::read_only, 0, 1073741828>;
+    using status_level_base_t = tsri::fields::field<4U, 4U, tsri::fields::field_types::read_only, 0, 1073741828>;
+    using intr_a_base_t = tsri::fields::field<0U, 1U, tsri::fields::field_types::write_clear, 0, 1073741832>;
+    using intr_b_base_t = tsri::fields::field<1U, 1U, tsri::fields::field_types::write_clear, 0, 1073741832>;
+    using intr_en_base_t = tsri::fields::field<8U, 1U, tsri::fields::field_types::read_write, 0, 1073741832>;
+    using data_data_base_t = tsri::fields::field<0U, 8U, tsri::fields::field_types::write_only, 0, 1073741836>;
+public:
+    struct CTRL : public tsri::registers::register_read_write<0x40000000U, 0x0U, 32U, 256U, true, ctrl_enable_base_t, ctrl_div_base_t, ctrl_start_base_t>
+    {
+        struct ENABLE : public ctrl_enable_base_t
+        {
+            using ctrl_enable_base_t::ctrl_enable_base_t;
+            using mask = ctrl_enable_base_t::mask;
+            struct bit : public ctrl_enable_base_t::bit
+            {
+                using ctrl_enable_base_t::bit::bit;
+                static constexpr auto BIT0 = ctrl_enable_base_t::bit{ 0U };
+            };
+            struct value
+            {
+                static constexpr auto zero = ctrl_enable_base_t::value{ 0U };
+                static constexpr auto one = ctrl_enable_base_t::value{ 1U };
+                value() = delete;
+            };
+        };
+        struct DIV : public ctrl_div_base_t
+        {
+            using ctrl_div_base_t::ctrl_div_base_t;
+            using mask = ctrl_div_base_t::mask;
+            struct bit : public ctrl_div_base_t::bit
+            {
+                using ctrl_div_base_t::bit::bit;
+                static constexpr auto BIT0 = ctrl_div_base_t::bit{ 0U };
+                static constexpr auto BIT1 = ctrl_div_base_t::bit{ 1U };
+                static constexpr auto BIT2 = ctrl_div_base_t::bit{ 2U };
+                static constexpr auto BIT3 = ctrl_div_base_t::bit{ 3U };
+                static constexpr auto BIT7 = ctrl_div_base_t::bit{ 7U };
+            };
+            struct value : ctrl_div_base_t::value
+            {
+                using ctrl_div_base_t::value::value;
+            };
+        };
+        struct START : public ctrl_start_base_t
+        {
+            using ctrl_start_base_t::ctrl_start_base_t;
+            using mask = ctrl_start_base_t::mask;
+            struct bit : public ctrl_start_base_t::bit
+            {
+                using ctrl_start_base_t::bit::bit;
+                static constexpr auto BIT0 = ctrl_start_base_t::bit{ 0U };
+            };
+            struct value
+            {
+                static constexpr auto one = ctrl_start_base_t::value{ 1U };
+                value() = delete;
+            };
+        };
+    };
+    struct STATUS : public tsri::registers::register_read_only<0x40000000U, 0x4U, 32U, status_ready_base_t, status_level_base_t>
+    {
+        struct READY : public status_ready_base_t
+        {
+            using status_ready_base_t::status_ready_base_t;
+            using mask = status_ready_base_t::mask;
+            struct bit : public status_ready_base_t::bit
+            {
+                using status_ready_base_t::bit::bit;
+                static constexpr auto BIT0 = status_ready_base_t::bit{ 0U };
+            };
+        };
+        struct LEVEL : public status_level_base_t
+        {
+            using status_level_base_t::status_level_base_t;
+            using mask = status_level_base_t::mask;
+            struct bit : public status_level_base_t::bit
+            {
+                using status_level_base_t::bit::bit;
+                static constexpr auto BIT0 = status_level_base_t::bit{ 0U };
+            };
+        };
+    };
+    struct INTR : public tsri::registers::register_read_write<0x40000000U, 0x8U, 32U, 0U, true, intr_a_base_t, intr_b_base_t, intr_en_base_t>
+    {
+        struct A : public intr_a_base_t
+        {
+            using intr_a_base_t::intr_a_base_t;
+            using mask = intr_a_base_t::mask;
+            struct bit : public intr_a_base_t::bit
+            {
+                using intr_a_base_t::bit::bit;
+                static constexpr auto BIT0 = intr_a_base_t::bit{ 0U };
+            };
+            struct value
+            {
+                static constexpr auto one = intr_a_base_t::value{ 1U };
+                value() = delete;
+            };
+        };
+        struct B : public intr_b_base_t
+        {
+            using intr_b_base_t::intr_b_base_t;
+            using mask = intr_b_base_t::mask;
+            struct bit : public intr_b_base_t::bit
+            {
+                using intr_b_base_t::bit::bit;
+                static constexpr auto BIT0 = intr_b_base_t::bit{ 0U };
+            };
+            struct value
+            {
+                static constexpr auto one = intr_b_base_t::value{ 1U };
+                value() = delete;
+            };
+        };
+        struct EN : public intr_en_base_t
+        {
+            using intr_en_base_t::intr_en_base_t;
+            using mask = intr_en_base_t::mask;
+            struct bit : public intr_en_base_t::bit
+            {
+                using intr_en_base_t::bit::bit;
+                static constexpr auto BIT0 = intr_en_base_t::bit{ 0U };
+            };
+            struct value
+            {
+                static constexpr auto zero = intr_en_base_t::value{ 0U };
+                static constexpr auto one = intr_en_base_t::value{ 1U };
+                value() = delete;
+            };
+        };
+    };
+    struct DATA : public tsri::registers::register_write_only<0x40000000U, 0xCU, 32U, 0U, false, data_data_base_t>
+    {
+        struct DATA_ : public data_data_base_t
+        {
+            using data_data_base_t::data_data_base_t;
+            using mask = data_data_base_t::mask;
+            struct bit : public data_data_base_t::bit
+            {
+                using data_data_base_t::bit::bit;
+                static constexpr auto BIT0 = data_data_base_t::bit{ 0U };
+            };
+            struct value : data_data_base_t::value
+            {
+                using data_data_base_t::value::value;
+            };
+        };
+    };
+    PERIPH() = delete;
+};
+
+}  // namespace test
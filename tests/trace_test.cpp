@@ -0,0 +1,92 @@
+/**
+ * @file trace_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the register access trace on the simulator, and writes a dump of it for `codegen/decode_trace.py`.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * Built with `TSRI_OPTION_BACKEND_SIMULATOR` and `TSRI_OPTION_TRACE`. The test peripheral has a trace map, as generated
+ * with `--trace`. If a path is passed, the test writes the raw trace buffer to it, like `dump binary value` in GDB, so
+ * the decoder can be tested on the same accesses.
+ */
+#include <array>
+#include <cstdint>
+#include <cstdio>
+
+#include "tsri/backends/backend.hpp"
+
+template<>
+struct tsri::backends::trace_map<0x40000000U>
+{
+    static constexpr std::uint16_t peripheral_index = 3U;
+
+    static constexpr std::array<tsri::utility::types::register_address_t, 4U> offsets{ { 0x0U, 0x4U, 0x8U, 0xCU } };
+};
+
+#include "test.hpp"
+#include "test_peripheral.hpp"
+
+using sim = tsri::backends::simulator;
+using tsri::backends::trace_kind;
+using namespace test;
+
+namespace
+{
+
+/**
+ * @brief Returns the trace entry of an access of the register with `register_index` of the test peripheral.
+ */
+constexpr auto make_entry(const trace_kind kind, const std::uint64_t register_index, const std::uint32_t value)
+    -> std::uint64_t
+{
+    return (static_cast<std::uint64_t>(kind) << 60U) | (std::uint64_t{ 3U } << 48U) | (register_index << 32U) | value;
+}
+
+void test_accesses_are_recorded()
+{
+    PERIPH::CTRL::set_fields(PERIPH::CTRL::DIV::value{ 7U });
+    sim::set(PERIPH_BASE_ADDRESS + 0x4U, 0x31U);
+    (void)PERIPH::STATUS::get();
+    PERIPH::DATA::set_fields_overwrite(PERIPH::DATA::DATA_::value{ 0x5AU });
+    PERIPH::CTRL::clear_fields<PERIPH::CTRL::ENABLE>();
+
+    const auto& trace = tsri::backends::trace_buffer;
+
+    check(trace.magic == 0x54525354U);
+    check(trace.position == 5U);
+    check(trace.entries[0] == make_entry(trace_kind::read, 0U, 0x0U));
+    check(trace.entries[1] == make_entry(trace_kind::write, 0U, 0x700U));
+    check(trace.entries[2] == make_entry(trace_kind::read, 1U, 0x31U));
+    check(trace.entries[3] == make_entry(trace_kind::write, 3U, 0x5AU));
+    check(trace.entries[4] == make_entry(trace_kind::write_clear, 0U, 0x1U));
+}
+
+/**
+ * @brief Writes the raw trace buffer to the file at `path`.
+ */
+void dump_trace(const char* const path)
+{
+    std::FILE* const file = std::fopen(path, "wb");
+
+    check(file != nullptr);
+
+    if (file != nullptr)
+    {
+        check(std::fwrite(&tsri::backends::trace_buffer, sizeof(tsri::backends::trace_buffer), 1U, file) == 1U);
+        std::fclose(file);
+    }
+}
+
+}  // namespace
+
+auto main(const int argc, const char* const argv[]) -> int
+{
+    test_accesses_are_recorded();
+
+    if (argc > 1)
+    {
+        dump_trace(argv[1]);
+    }
+
+    return result();
+}
@@ -0,0 +1,172 @@
+/**
+ * @file transport_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Tests the transport backend and the coalescing of register accesses into bursts, on a `loopback_bus`.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * The sensor below has the register map of a small I2C chip: an 8-bit identification register, three 16-bit samples
+ * after a gap of one byte, and two 32-bit configuration registers. The loopback bus counts the transactions, so the
+ * test can check that adjacent registers are accessed in one burst.
+ */
+#include <cstddef>
+#include <cstdint>
+
+#include "tsri/backends/backend.hpp"
+
+/* Base address that identifies the sensor. */
+constexpr tsri::utility::types::register_address_t SENSOR_BASE_ADDRESS = 0x1000U;
+
+using bus_t = tsri::backends::loopback_bus<64U>;
+
+template<>
+struct tsri::backends::peripheral_backend<SENSOR_BASE_ADDRESS>
+{
+    using type = tsri::backends::transport<bus_t>;
+};
+
+#include "tsri/tsri.hpp"
+#include "test.hpp"
+
+using namespace test;
+
+namespace
+{
+
+class SENSOR :
+    public tsri::peripherals::peripheral<SENSOR_BASE_ADDRESS>,
+    public tsri::peripherals::retained_registers<SENSOR_BASE_ADDRESS, 0x10U, 0x14U>
+{
+private:
+    using id_id_base_t    = tsri::fields::field<0U, 8U, tsri::fields::field_types::read_only, 0, 0x1000U, 8U>;
+    using x_x_base_t      = tsri::fields::field<0U, 16U, tsri::fields::field_types::read_only, 0, 0x1002U, 16U>;
+    using y_y_base_t      = tsri::fields::field<0U, 16U, tsri::fields::field_types::read_only, 0, 0x1004U, 16U>;
+    using z_z_base_t      = tsri::fields::field<0U, 16U, tsri::fields::field_types::read_only, 0, 0x1006U, 16U>;
+    using cfg_rate_base_t = tsri::fields::field<0U, 8U, tsri::fields::field_types::read_write, 0, 0x1010U>;
+    using cfg_gain_base_t = tsri::fields::field<8U, 8U, tsri::fields::field_types::read_write, 0, 0x1010U>;
+    using thr_thr_base_t  = tsri::fields::field<0U, 8U, tsri::fields::field_types::read_write, 0, 0x1014U>;
+
+public:
+    struct ID : public tsri::registers::register_read_only<SENSOR_BASE_ADDRESS, 0x0U, 8U, id_id_base_t>
+    {
+        struct ID_ : public id_id_base_t
+        {};
+    };
+
+    struct X : public tsri::registers::register_read_only<SENSOR_BASE_ADDRESS, 0x2U, 16U, x_x_base_t>
+    {};
+
+    struct Y : public tsri::registers::register_read_only<SENSOR_BASE_ADDRESS, 0x4U, 16U, y_y_base_t>
+    {};
+
+    struct Z : public tsri::registers::register_read_only<SENSOR_BASE_ADDRESS, 0x6U, 16U, z_z_base_t>
+    {};
+
+    struct CFG :
+        public tsri::registers::register_read_write<SENSOR_BASE_ADDRESS, 0x10U, 32U, 0U, false, cfg_rate_base_t,
+                                                    cfg_gain_base_t>
+    {
+        struct RATE : public cfg_rate_base_t
+        {
+            using value = cfg_rate_base_t::value;
+        };
+
+        struct GAIN : public cfg_gain_base_t
+        {
+            using value = cfg_gain_base_t::value;
+        };
+    };
+
+    struct THR : public tsri::registers::register_read_write<SENSOR_BASE_ADDRESS, 0x14U, 32U, 0U, false, thr_thr_base_t>
+    {
+        struct THR_ : public thr_thr_base_t
+        {
+            using value = thr_thr_base_t::value;
+        };
+    };
+
+    SENSOR() = delete;
+};
+
+/**
+ * @brief Resets the transaction counters of `bus`.
+ */
+void reset_counts(bus_t& bus)
+{
+    bus.reads  = 0U;
+    bus.writes = 0U;
+}
+
+void test_read_coalesces_adjacent_registers(bus_t& bus)
+{
+    constexpr std::uint8_t contents[] = { 0x68U, 0x00U, 0x12U, 0x34U, 0xABU, 0xCDU, 0x00U, 0x01U };
+
+    for (std::size_t index = 0U; index < sizeof(contents); index++)
+    {
+        bus.memory[index] = std::byte{ contents[index] };
+    }
+
+    reset_counts(bus);
+
+    const auto values = SENSOR::read<SENSOR::ID, SENSOR::X, SENSOR::Y, SENSOR::Z>();
+
+    /* Big-endian registers. ID is one burst, X to Z another: the byte at 0x1 is not a register. */
+    check(values.get<SENSOR::ID>() == 0x68U);
+    check(values.get<SENSOR::X>() == 0x1234U);
+    check(values.get<SENSOR::Y>() == 0xABCDU);
+    check(values.get<SENSOR::Z>() == 0x0001U);
+    check(bus.reads == 2U and bus.writes == 0U);
+}
+
+void test_read_modify_write(bus_t& bus)
+{
+    reset_counts(bus);
+
+    SENSOR::CFG::set_fields(SENSOR::CFG::RATE::value{ 5U }, SENSOR::CFG::GAIN::value{ 6U });
+
+    check(bus.reads == 1U and bus.writes == 1U);
+    check(SENSOR::CFG::get() == 0x605U);
+}
+
+void test_apply_coalesces_adjacent_writes(bus_t& bus)
+{
+    reset_counts(bus);
+
+    SENSOR::apply(SENSOR::CFG::defer_set_fields(SENSOR::CFG::RATE::value{ 7U }),
+                  SENSOR::THR::defer_set_fields_overwrite(SENSOR::THR::THR_::value{ 9U }));
+
+    /* CFG is read for its read-modify-write, then CFG and THR are written in one burst. */
+    check(bus.reads == 1U and bus.writes == 1U);
+    check(SENSOR::CFG::get() == 0x607U);
+    check(SENSOR::THR::get() == 0x9U);
+}
+
+void test_save_and_restore_are_one_burst_each(bus_t& bus)
+{
+    reset_counts(bus);
+
+    const auto saved = SENSOR::save();
+
+    bus.memory[0x13U] = std::byte{ 0U };
+    SENSOR::restore(saved);
+
+    check(bus.reads == 1U and bus.writes == 1U);
+    check(bus.memory[0x12U] == std::byte{ 0x06U } and bus.memory[0x13U] == std::byte{ 0x07U });
+    check(bus.memory[0x17U] == std::byte{ 0x09U });
+}
+
+}  // namespace
+
+auto main() -> int
+{
+    bus_t bus;
+
+    tsri::backends::transport<bus_t>::attach<SENSOR_BASE_ADDRESS>(bus);
+
+    test_read_coalesces_adjacent_registers(bus);
+    test_read_modify_write(bus);
+    test_apply_coalesces_adjacent_writes(bus);
+    test_save_and_restore_are_one_burst_each(bus);
+
+    return result();
+}
@@ -0,0 +1,77 @@
+/**
+ * @file zbs_size_check.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Single-bit operations whose code is checked for RV32 cores with Zbs, see `size_check.cmake`.
+ * @version 0.1
+ * @date 2025-08-10
+ *
+ * This file is not run. It is compiled with clang for riscv32, with and without Zbs, and each function is checked for
+ * its Zbs instruction and for not growing. The register has no atomic aliases, so every operation is a read, a bit
+ * instruction and a write on the memory-mapped backend.
+ */
+#include "tsri/tsri.hpp"
+
+namespace
+{
+
+/* Base address of the peripheral. */
+constexpr tsri::utility::types::register_address_t FLAGS_BASE_ADDRESS = 0x50000000U;
+
+using flags_pend_base_t  = tsri::fields::field<0U, 1U, tsri::fields::field_types::write_clear, 0, FLAGS_BASE_ADDRESS>;
+using flags_ready_base_t = tsri::fields::field<4U, 1U, tsri::fields::field_types::read_only, 0, FLAGS_BASE_ADDRESS>;
+using flags_mode_base_t  = tsri::fields::field<8U, 8U, tsri::fields::field_types::read_write, 0, FLAGS_BASE_ADDRESS>;
+
+struct FLAGS :
+    public tsri::registers::register_read_write<FLAGS_BASE_ADDRESS, 0x0U, 32U, 0U, false, flags_pend_base_t,
+                                                flags_ready_base_t, flags_mode_base_t>
+{
+    struct READY : public flags_ready_base_t
+    {};
+
+    struct MODE : public flags_mode_base_t
+    {
+        using flags_mode_base_t::flags_mode_base_t;
+
+        struct bit : public flags_mode_base_t::bit
+        {
+            using flags_mode_base_t::bit::bit;
+        };
+    };
+};
+
+}  // namespace
+
+/* Each function is expected to contain the instruction in its name after the operation, see `size_check.cmake`. */
+extern "C"
+{
+
+void set_bits_bset(const unsigned position)
+{
+    FLAGS::set_bits(FLAGS::MODE{ FLAGS::MODE::bit{ position } });
+}
+
+void set_bit_bset(const unsigned position)
+{
+    FLAGS::set_bit(FLAGS::MODE::bit{ position });
+}
+
+void clear_bit_bclr(const unsigned position)
+{
+    FLAGS::clear_bit(FLAGS::MODE::bit{ position });
+}
+
+void toggle_bit_binv(const unsigned position)
+{
+    FLAGS::toggle_bit(FLAGS::MODE::bit{ position });
+}
+
+auto extract_bit_bext(const unsigned position) -> unsigned
+{
+    return tsri::utility::bits::extract_bit(FLAGS::get(), position);
+}
+
+auto get_ready_bexti() -> unsigned
+{
+    return FLAGS::get_fields<FLAGS::READY>().get();
+}
+}